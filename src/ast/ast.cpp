@@ -1372,6 +1372,7 @@ static void mark_array_ref(ast_mark& mark, unsigned sz, parameter const * a) {
 ast_manager::~ast_manager() {
     SASSERT(is_format_manager() || !m_family_manager.has_family(symbol("format")));
 
+    reset_rewrite_cache();
     dec_ref(m_bool_sort);
     dec_ref(m_proof_sort);
     dec_ref(m_true);
@@ -1641,6 +1642,53 @@ quantifier* ast_manager::is_lambda_def(func_decl* f) {
     return nullptr;
 }
 
+expr* ast_manager::find_rewrite(unsigned fp, expr* e) const {
+    if (m_rewrite_cache.empty())
+        return nullptr;
+    auto* entry = m_rewrite_cache.find_core(rewrite_key(fp, e));
+    return entry ? entry->get_data().m_value.second : nullptr;
+}
+
+void ast_manager::insert_rewrite(unsigned fp, expr* e, expr* r) {
+    SASSERT(e->get_sort() == r->get_sort());
+    if (!m_rewrite_cache_fps.contains(fp)) {
+        // every deletion probes each fingerprint, keep their number small.
+        if (m_rewrite_cache_fps.size() >= 8)
+            reset_rewrite_cache();
+        m_rewrite_cache_fps.push_back(fp);
+    }
+    auto& v = m_rewrite_cache.insert_if_not_there(rewrite_key(fp, e), std::pair<expr*, expr*>(nullptr, nullptr));
+    if (v.first)
+        return;
+    if (r != e)
+        inc_ref(r);
+    v = std::make_pair(e, r);
+}
+
+void ast_manager::reset_rewrite_cache() {
+    ptr_buffer<expr> to_delete;
+    for (auto const& kv : m_rewrite_cache)
+        if (kv.m_value.first != kv.m_value.second)
+            to_delete.push_back(kv.m_value.second);
+    m_rewrite_cache.reset();
+    m_rewrite_cache_fps.reset();
+    for (expr* r : to_delete)
+        dec_ref(r);
+}
+
+void ast_manager::erase_rewrite(expr* e) {
+    for (unsigned fp : m_rewrite_cache_fps) {
+        uint64_t k = rewrite_key(fp, e);
+        auto* entry = m_rewrite_cache.find_core(k);
+        if (!entry)
+            continue;
+        expr* r = entry->get_data().m_value.second;
+        m_rewrite_cache.erase(k);
+        if (r != e)
+            push_dec_ref(r);
+    }
+}
+
 
 void ast_manager::register_plugin(family_id id, decl_plugin * plugin) {
     SASSERT(m_plugins.get(id, 0) == 0);
@@ -1816,6 +1864,9 @@ void ast_manager::delete_node(ast * n) {
 
         SASSERT(!m_debug_ref_count || !m_debug_free_indices.contains(n->m_id));
 
+        if (!m_rewrite_cache.empty() && is_expr(n))
+            erase_rewrite(to_expr(n));
+
 #ifdef RECYCLE_FREE_AST_INDICES
         if (!m_debug_ref_count) {
             if (is_decl(n))
@@ -1511,6 +1511,8 @@ protected:
     bool                      m_int_real_coercions; // If true, use hack that automatically introduces to_int/to_real when needed.
     ast_table                 m_ast_table;
     obj_map<func_decl, quantifier*> m_lambda_defs;
+    u64_map<std::pair<expr*, expr*>> m_rewrite_cache; // (fingerprint, expr id) -> (expr, normal form)
+    unsigned_vector           m_rewrite_cache_fps;
     id_gen                    m_expr_id_gen;
     id_gen                    m_decl_id_gen;
     sort *                    m_bool_sort;
@@ -1649,6 +1651,18 @@ public:
 
     symbol const& lambda_def_qid() const { return m_lambda_def; }
 
+    /**
+       \brief Persistent cache of rewriting results shared by all rewriters
+       of this manager. Results are indexed by the rewritten expression and
+       a fingerprint of the rewriter configuration. The expression is not
+       referenced by the cache: its entries are removed when it is deleted.
+       The normal form is referenced, unless it is the expression itself.
+    */
+    expr* find_rewrite(unsigned fp, expr* e) const;
+    void insert_rewrite(unsigned fp, expr* e, expr* r);
+    void reset_rewrite_cache();
+    unsigned get_rewrite_cache_size() const { return m_rewrite_cache.size(); }
+
     unsigned get_num_asts() const { return m_ast_table.size(); }
 
     void debug_ref_count() { m_debug_ref_count = true; }
@@ -1698,6 +1712,9 @@ protected:
 
     void delete_node(ast * n);
 
+    static uint64_t rewrite_key(unsigned fp, expr* e) { return (static_cast<uint64_t>(fp) << 32) | e->get_id(); }
+    void erase_rewrite(expr* e);
+
     void * allocate_node(unsigned size) {
         return m_alloc.allocate(size);
     }
@@ -54,6 +54,7 @@ namespace euf {
         unsigned      m_class_size = 1;         // Size of the equivalence class if the enode is the root.
         unsigned      m_table_id = UINT_MAX;       
         unsigned      m_generation = 0;         // Tracks how many quantifier instantiation rounds were needed to generate this enode.
+        unsigned      m_hash = 0;               // Id of m_expr, cached for congruence table lookups.
         enode_vector  m_parents;
         enode*        m_next   = nullptr;
         enode*        m_root   = nullptr;
@@ -84,6 +85,7 @@ namespace euf {
             void* mem = r.allocate(get_enode_size(num_args));
             enode* n = new (mem) enode();
             n->m_expr = f;
+            n->m_hash = f->get_id();
             n->m_next = n;
             n->m_root = n;
             n->m_generation = generation, 
@@ -161,7 +163,7 @@ namespace euf {
         bool merge_tf() const { return m_merge_tf_enabled && (class_size() > 1 || num_parents() > 0 || num_args() > 0); }
 
         enode* get_arg(unsigned i) const { SASSERT(i < num_args()); return m_args[i]; }        
-        unsigned hash() const { return m_expr->get_id(); }
+        unsigned hash() const { return m_hash; }
 
         unsigned get_table_id() const { return m_table_id; }
         void     set_table_id(unsigned t) { m_table_id = t; }
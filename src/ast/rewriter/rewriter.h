@@ -228,6 +228,8 @@ protected:
     proof_ref                  m_pr;
     proof_ref                  m_pr2;
     unsigned_vector            m_shifts;
+    bool                       m_persist = false; // use the persistent rewrite cache of the manager.
+    unsigned                   m_persist_fp = 0;
 
     svector<frame> & frame_stack() { return this->m_frame_stack; }
     svector<frame> const & frame_stack() const { return this->m_frame_stack; }
@@ -286,6 +288,16 @@ protected:
         return false;
     }
 
+    // Return true if the rewriting result of t is kept in the persistent cache of the manager.
+    // Only results for the top-level scope are stored, including the one for the root expression.
+    bool must_persist(expr * t, bool c) const {
+        if (!m_persist || !this->m_scopes.empty())
+            return false;
+        if (c)
+            return true;
+        return t == this->m_root && ((is_app(t) && to_app(t)->get_num_args() > 0) || is_quantifier(t));
+    }
+
     bool get_macro(func_decl * f, expr * & def, proof * & def_pr) {
         quantifier* q = nullptr;
         return m_cfg.get_macro(f, def, q, def_pr); 
@@ -318,6 +330,8 @@ protected:
             else
                 rewriter_core::cache_result(t, new_t, pr);
         }
+        if (!ProofGen && must_persist(t, c) && m().inc())
+            m().insert_rewrite(m_persist_fp, t, new_t);
     }
 
     template<bool ProofGen>
@@ -394,6 +408,9 @@ struct default_rewriter_cfg {
     bool get_macro(func_decl * d, expr * & def, quantifier * & q, proof * & def_pr) { return false; }
     bool reduce_macro() { return false; }
     bool get_subst(expr * s, expr * & t, proof * & t_pr) { return false; }
+    // Return true if rewriting results may be shared through the persistent
+    // cache of the manager. fp identifies the configuration of the rewriter.
+    bool persistent_cache(unsigned & fp) const { return false; }
     void reset() {}
     void cleanup() {}
 };
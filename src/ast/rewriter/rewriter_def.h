@@ -185,6 +185,14 @@ bool rewriter_tpl<Config>::visit(expr * t, unsigned max_depth) {
             return true;
         }
     }
+    if (!ProofGen && must_persist(t, c)) {
+        expr * r = m().find_rewrite(m_persist_fp, t);
+        if (r) {
+            result_stack().push_back(r);
+            set_new_child_flag(t, r);
+            return true;
+        }
+    }
     if (!pre_visit(t)) {
         result_stack().push_back(t);
         if (ProofGen)
@@ -726,6 +734,7 @@ void rewriter_tpl<Config>::main_loop(expr * t, expr_ref & result, proof_ref & re
     m_root      = t;
     m_num_qvars = 0;
     m_num_steps = 0;    
+    m_persist   = !ProofGen && m_bindings.empty() && m_cfg.persistent_cache(m_persist_fp);
     if (visit<ProofGen>(t, RW_UNBOUNDED_DEPTH)) {
         result = result_stack().back();
         result_stack().pop_back();
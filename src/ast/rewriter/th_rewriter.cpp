@@ -41,6 +41,7 @@ Notes:
 #include "ast/well_sorted.h"
 #include "ast/for_each_expr.h"
 #include "ast/array_peq.h"
+#include "util/gparams.h"
 
 namespace {
 struct th_rewriter_cfg : public default_rewriter_cfg {
@@ -79,6 +80,9 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
     bool                m_rewrite_patterns = true;
     bool                m_enable_der = true;
     bool                m_nested_der = false;
+    bool                m_persistent_cache = false;
+    unsigned            m_params_fp = 0;
+    bool                m_has_solver = false;
 
 
     ast_manager & m() const { return m_b_rw.m(); }
@@ -97,6 +101,21 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
         m_rewrite_patterns = p.rewrite_patterns();
         m_enable_der     = p.enable_der();
         m_nested_der     = _p.get_bool("nested_der", false);
+        m_persistent_cache = p.persistent_cache();
+        if (m_persistent_cache) {
+            std::ostringstream strm;
+            _p.display(strm);
+            gparams::get_module("rewriter").display(strm);
+            std::string s = strm.str();
+            m_params_fp = string_hash(s.c_str(), static_cast<unsigned>(s.size()), 17);
+        }
+    }
+
+    bool persistent_cache(unsigned & fp) const {
+        if (!m_persistent_cache || m_subst || m_has_solver)
+            return false;
+        fp = combine_hash(m_params_fp, (m_b_rw.flat_and_or() ? 1 : 0) + (m_b_rw.order_eq() ? 2 : 0));
+        return true;
     }
 
     void updt_params(params_ref const & p) {
@@ -1058,6 +1077,7 @@ expr_ref th_rewriter::mk_eq(expr* a, expr* b) {
 }
 
 void th_rewriter::set_solver(expr_solver* solver) {
+    m_imp->cfg().m_has_solver = solver != nullptr;
     m_imp->set_solver(solver);
 }
 
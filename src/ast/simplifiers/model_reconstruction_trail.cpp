@@ -80,7 +80,9 @@ void model_reconstruction_trail::replay(unsigned qhead, expr_ref_vector& assumpt
                 add_vars(v, free_vars);
                 st.add(dependent_expr(m, m.mk_eq(k, v), nullptr, nullptr));
             }
+            m_trail_stack.push(value_trail(t->m_active));
             t->m_active = false;
+            updated();
             continue;
         }
         
@@ -90,7 +92,9 @@ void model_reconstruction_trail::replay(unsigned qhead, expr_ref_vector& assumpt
                 TRACE("simplifier", tout << "replay removed " << r << "\n");
                 st.add(r);
             }
+            m_trail_stack.push(value_trail(t->m_active));
             t->m_active = false;
+            updated();
             continue;
         }
 
@@ -107,6 +111,7 @@ void model_reconstruction_trail::replay(unsigned qhead, expr_ref_vector& assumpt
             }
             m_trail_stack.push(value_trail(t->m_active));
             t->m_active = false;      
+            updated();
             continue;
         }        
         
@@ -196,9 +201,13 @@ void model_reconstruction_trail::replay(unsigned qhead, expr_ref_vector& assumpt
  * retrieve the current model converter corresponding to chaining substitutions from the trail.
  */
 model_converter_ref model_reconstruction_trail::get_model_converter() {
+    if (m_mc && m_mc_updates == m_num_updates)
+        return m_mc;
     generic_model_converter_ref mc = alloc(generic_model_converter, m, "dependent-expr-model");
     append(*mc);
-    return model_converter_ref(mc.get());
+    m_mc = mc.get();
+    m_mc_updates = m_num_updates;
+    return m_mc;
 }
 
 /**
@@ -93,6 +93,24 @@ class model_reconstruction_trail {
     func_decl_ref_vector     m_model_vars_trail;
     ast_mark                 m_model_vars;
     bool                     m_intersects_with_model = false;
+    unsigned                 m_num_updates = 0;        // changes to the trail, including undone changes
+    unsigned                 m_mc_updates = UINT_MAX;  // value of m_num_updates when m_mc was built
+    model_converter_ref      m_mc;
+
+    struct undo_update : public trail {
+        model_reconstruction_trail& s;
+        undo_update(model_reconstruction_trail& s) : s(s) {}
+        void undo() override { s.m_num_updates++; }
+    };
+
+    /**
+    * record a change to the trail. The change and its undo
+    * invalidate the cached model converter.
+    */
+    void updated() {
+        m_num_updates++;
+        m_trail_stack.push(undo_update(*this));
+    }
 
     struct undo_model_var : public trail {
         model_reconstruction_trail& s;
@@ -151,6 +169,7 @@ public:
     void push(expr_substitution* s, vector<dependent_expr> const& removed, bool replay_constraints) {
         m_trail.push_back(alloc(entry, m, s, removed, replay_constraints));
         m_trail_stack.push(push_back_vector(m_trail));     
+        updated();
         for (auto& [k, v] : s->sub())
             add_model_var(to_app(k)->get_decl());
     }
@@ -161,6 +180,7 @@ public:
     void hide(func_decl* f) {
         m_trail.push_back(alloc(entry, m, f));
         m_trail_stack.push(push_back_vector(m_trail));
+        updated();
     }
 
     /**
@@ -169,6 +189,7 @@ public:
     void push(func_decl* f, expr* def, expr_dependency* dep, vector<dependent_expr> const& removed) {
         m_trail.push_back(alloc(entry, m, f, def, dep, removed));
         m_trail_stack.push(push_back_vector(m_trail));
+        updated();
         add_model_var(f);
     }
 
@@ -178,6 +199,7 @@ public:
     void push(vector<std::tuple<func_decl_ref, expr_ref, expr_dependency_ref>> const& defs, vector<dependent_expr> const& removed) {
         m_trail.push_back(alloc(entry, m, defs, removed));
         m_trail_stack.push(push_back_vector(m_trail));
+        updated();
         for (auto const& [f, def, dep] : defs)
             add_model_var(f);
     }
@@ -191,6 +213,7 @@ public:
 
     /**
      * retrieve the current model converter corresponding to chaining substitutions from the trail.
+     * The converter is rebuilt only if the trail changed since the previous call.
      */
     model_converter_ref get_model_converter();
 
@@ -0,0 +1,255 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    parallel_simplifier.cpp
+
+Abstract:
+
+    Run simplifiers on independent groups of assertions in parallel.
+
+Author:
+
+    agent 2026-10-17
+
+--*/
+
+#include "util/union_find.h"
+#include "util/scoped_ptr_vector.h"
+#include "ast/ast_translation.h"
+#include "ast/recfun_decl_plugin.h"
+#include "ast/simplifiers/parallel_simplifier.h"
+
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
+
+namespace {
+
+    /**
+    * Assertions of the components handled by one thread.
+    * Updates are recorded so that only changed assertions are translated back.
+    */
+    class component_state : public dependent_expr_state {
+        ast_manager&           m;
+        vector<dependent_expr> m_fmls;
+        bool_vector            m_changed;
+        bool                   m_inconsistent = false;
+        bool                   m_updated = false;
+    public:
+        component_state(ast_manager& m) : dependent_expr_state(m), m(m) {}
+
+        void init(dependent_expr const& j) {
+            m_fmls.push_back(j);
+            m_changed.push_back(false);
+        }
+
+        bool changed(unsigned i) const { return m_changed[i]; }
+
+        unsigned qtail() const override { return m_fmls.size(); }
+        dependent_expr const& operator[](unsigned i) override { return m_fmls[i]; }
+        void update(unsigned i, dependent_expr const& j) override {
+            m_fmls[i] = j;
+            m_changed[i] = true;
+            m_updated = true;
+            m_inconsistent |= m.is_false(j.fml());
+        }
+        void add(dependent_expr const& j) override {
+            m_fmls.push_back(j);
+            m_changed.push_back(true);
+            m_updated = true;
+            m_inconsistent |= m.is_false(j.fml());
+        }
+        bool inconsistent() override { return m_inconsistent; }
+        model_reconstruction_trail& model_trail() override {
+            throw default_exception("model reconstruction is not supported by parallel simplification");
+        }
+        bool updated() override { return m_updated; }
+        void reset_updated() override { m_updated = false; }
+    };
+}
+
+parallel_simplifier::parallel_simplifier(ast_manager& m, params_ref const& p, dependent_expr_state& fmls, unsigned num_threads):
+    dependent_expr_simplifier(m, fmls),
+    m_params(p),
+    m_num_threads(num_threads),
+    m_sequential(m, p, fmls) {
+}
+
+void parallel_simplifier::add_simplifier(simplifier_factory const& f) {
+    m_factories.push_back(f);
+    m_sequential.add_simplifier(f(m, m_params, m_fmls));
+}
+
+void parallel_simplifier::reduce() {
+    if (!reduce_parallel())
+        m_sequential.reduce();
+}
+
+/**
+* Partition the suffix into connected components of assertions that
+* share uninterpreted symbols. Values and other interpreted terms do not
+* connect assertions. Each component is weighted by the number of
+* distinct sub-terms of its assertions.
+*/
+void parallel_simplifier::get_components(vector<unsigned_vector>& components, unsigned_vector& weights) {
+    basic_union_find uf;
+    obj_map<func_decl, unsigned> decl2fml;
+    unsigned_vector visited;    // expression id -> 1 + local index of the last assertion that visited it
+    unsigned_vector num_exprs;
+    ptr_vector<expr> todo;
+    for (unsigned i : indices()) {
+        unsigned k = uf.mk_var();
+        num_exprs.push_back(0);
+        todo.push_back(m_fmls[i].fml());
+        while (!todo.empty()) {
+            expr* e = todo.back();
+            todo.pop_back();
+            unsigned id = e->get_id();
+            if (id < visited.size() && visited[id] == k + 1)
+                continue;
+            visited.setx(id, k + 1, 0);
+            ++num_exprs[k];
+            if (m.is_value(e))
+                continue;
+            if (is_app(e)) {
+                func_decl* f = to_app(e)->get_decl();
+                unsigned j;
+                if (!is_uninterp(f))
+                    ;
+                else if (decl2fml.find(f, j))
+                    uf.merge(k, j);
+                else
+                    decl2fml.insert(f, k);
+                todo.append(to_app(e)->get_num_args(), to_app(e)->get_args());
+            }
+            else if (is_quantifier(e))
+                todo.push_back(to_quantifier(e)->get_expr());
+        }
+    }
+    u_map<unsigned> root2component;
+    for (unsigned k = 0; k < uf.get_num_vars(); ++k) {
+        unsigned r = uf.find(k), c;
+        if (!root2component.find(r, c)) {
+            c = components.size();
+            root2component.insert(r, c);
+            components.push_back(unsigned_vector());
+            weights.push_back(0);
+        }
+        components[c].push_back(qhead() + k);
+        weights[c] += num_exprs[k];
+    }
+}
+
+bool parallel_simplifier::reduce_parallel() {
+#ifdef SINGLE_THREAD
+    return false;
+#else
+    unsigned num_threads = m_num_threads;
+    if (num_threads <= 1 || m.proofs_enabled() || m.has_trace_stream())
+        return false;
+    if (m_fmls.has_quantifiers() || recfun::util(m).has_defs())
+        return false;
+
+    vector<unsigned_vector> components;
+    unsigned_vector weights;
+    get_components(components, weights);
+    m_stats.m_num_components += components.size();
+    num_threads = std::min(num_threads, components.size());
+    if (num_threads <= 1)
+        return false;
+
+    // assign the heaviest components first, each to the least loaded thread.
+    unsigned_vector order, load;
+    vector<unsigned_vector> assigned;
+    for (unsigned c = 0; c < components.size(); ++c)
+        order.push_back(c);
+    std::stable_sort(order.begin(), order.end(), [&](unsigned a, unsigned b) { return weights[a] > weights[b]; });
+    load.resize(num_threads, 0);
+    assigned.resize(num_threads);
+    for (unsigned c : order) {
+        unsigned t = 0;
+        for (unsigned u = 1; u < num_threads; ++u)
+            if (load[u] < load[t])
+                t = u;
+        load[t] += weights[c];
+        assigned[t].append(components[c]);
+    }
+    IF_VERBOSE(10, verbose_stream() << "(parallel-simplifier :components " << components.size() << " :threads " << num_threads << ")\n");
+
+    scoped_ptr_vector<ast_manager> pms;
+    scoped_ptr_vector<component_state> states;
+    scoped_limits sl(m.limit());
+    for (unsigned t = 0; t < num_threads; ++t) {
+        ast_manager* pm = alloc(ast_manager, m, true);
+        pms.push_back(pm);
+        sl.push_child(&(pm->limit()));
+        states.push_back(alloc(component_state, *pm));
+        ast_translation tr(m, *pm);
+        for (unsigned i : assigned[t])
+            states[t]->init(dependent_expr(tr, m_fmls[i]));
+    }
+
+    bool_vector ok;
+    ok.resize(num_threads, true);
+    auto worker = [&](unsigned t) {
+        ast_manager& pm = *pms[t];
+        component_state& st = *states[t];
+        try {
+            scoped_ptr_vector<dependent_expr_simplifier> simplifiers;
+            for (auto const& f : m_factories)
+                simplifiers.push_back(f(pm, m_params, st));
+            for (auto* s : simplifiers) {
+                if (st.inconsistent() || !pm.inc())
+                    break;
+                s->reduce();
+            }
+        }
+        catch (z3_exception&) {
+            ok[t] = false;
+        }
+    };
+
+    vector<std::thread> threads;
+    for (unsigned t = 0; t < num_threads; ++t)
+        threads.push_back(std::thread([&, t]() { worker(t); }));
+    for (auto& th : threads)
+        th.join();
+
+    for (unsigned t = 0; t < num_threads; ++t) {
+        if (!ok[t])
+            continue;
+        component_state& st = *states[t];
+        unsigned_vector const& idx = assigned[t];
+        ast_translation tr(*pms[t], m);
+        for (unsigned j = 0; j < st.qtail(); ++j) {
+            if (!st.changed(j))
+                continue;
+            dependent_expr d(tr, st[j]);
+            if (j < idx.size())
+                m_fmls.update(idx[j], d);
+            else
+                m_fmls.add(d);
+        }
+    }
+    m_stats.m_num_parallel++;
+    return true;
+#endif
+}
+
+void parallel_simplifier::collect_statistics(statistics& st) const {
+    m_sequential.collect_statistics(st);
+    st.update("parallel-simplifier-components", m_stats.m_num_components);
+    st.update("parallel-simplifier-rounds", m_stats.m_num_parallel);
+}
+
+void parallel_simplifier::reset_statistics() {
+    m_sequential.reset_statistics();
+    m_stats.reset();
+}
+
+void parallel_simplifier::updt_params(params_ref const& p) {
+    m_params.append(p);
+    m_sequential.updt_params(p);
+}
@@ -0,0 +1,63 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    parallel_simplifier.h
+
+Abstract:
+
+    Run simplifiers on independent groups of assertions in parallel.
+
+    The assertions of the suffix are partitioned into connected components
+    of shared uninterpreted symbols. The components are distributed over
+    threads. Each thread translates its assertions into a private manager,
+    runs its own instances of the simplifiers and the results are
+    translated back.
+
+    The simplifiers have to be equivalence preserving and must not use
+    the model reconstruction trail, e.g., rewriter_simplifier,
+    propagate_values and bv_bounds_simplifier. The simplifiers are
+    applied sequentially on the full state when there are proofs,
+    quantifiers or recursive functions, or fewer than two components.
+
+Author:
+
+    agent 2026-10-17
+
+--*/
+
+#pragma once
+
+#include "ast/simplifiers/then_simplifier.h"
+
+
+class parallel_simplifier : public dependent_expr_simplifier {
+
+    struct stats {
+        unsigned m_num_components = 0;
+        unsigned m_num_parallel = 0;
+        void reset() { memset(this, 0, sizeof(*this)); }
+    };
+
+    params_ref                      m_params;
+    unsigned                        m_num_threads;
+    std::vector<simplifier_factory> m_factories;
+    then_simplifier                 m_sequential;
+    stats                           m_stats;
+
+    void get_components(vector<unsigned_vector>& components, unsigned_vector& weights);
+    bool reduce_parallel();
+
+public:
+    parallel_simplifier(ast_manager& m, params_ref const& p, dependent_expr_state& fmls, unsigned num_threads);
+    char const* name() const override { return "parallel"; }
+    void add_simplifier(simplifier_factory const& f);
+    void reduce() override;
+    void collect_statistics(statistics& st) const override;
+    void reset_statistics() override;
+    void updt_params(params_ref const& p) override;
+    void collect_param_descrs(param_descrs& r) override { m_sequential.collect_param_descrs(r); }
+    void push() override { m_sequential.push(); }
+    void pop(unsigned n) override { m_sequential.pop(n); }
+};
@@ -46,20 +46,24 @@ void propagate_values::process_fml(unsigned i) {
         }
         m_rewriter.reset_used_dependencies();
     }
-    add_sub(m_fmls[i]);
+    add_sub(m_fmls[i], false);
 }
 
-void propagate_values::add_sub(dependent_expr const& de) {
+/**
+* Formulas in the prefix are not rewritten, so their units are used
+* regardless of sharing. Sharing is only tracked for the suffix.
+*/
+void propagate_values::add_sub(dependent_expr const& de, bool in_prefix) {
     expr* x, * y;
     auto const& [f, p, dep] = de();
-    if (m.is_not(f, x) && m_shared.is_shared(x))
+    if (m.is_not(f, x) && is_shared(x, in_prefix))
         m_subst.insert(x, m.mk_false(), dep);
-    if (m_shared.is_shared(f))
+    if (is_shared(f, in_prefix))
         m_subst.insert(f, m.mk_true(), dep);
     if (m.is_eq(f, x, y)) {
-        if (m.is_value(x) && m_shared.is_shared(y))
+        if (m.is_value(x) && is_shared(y, in_prefix))
             m_subst.insert(y, x, dep);
-        else if (m.is_value(y) && m_shared.is_shared(x))
+        else if (m.is_value(y) && is_shared(x, in_prefix))
             m_subst.insert(x, y, dep);
     }
 };
@@ -68,10 +72,12 @@ void propagate_values::reduce() {
     m_shared.reset();
     m_subst.reset();
 
+    // the prefix is not traversed, it can be much larger than the suffix
+    // in incremental mode.
     auto add_shared = [&]() {
         shared_occs_mark visited;
         m_shared.reset();
-        for (unsigned i = 0; i < qtail(); ++i)
+        for (unsigned i = qhead(); i < qtail(); ++i)
             m_shared(m_fmls[i].fml(), visited);
     };   
    
@@ -81,7 +87,7 @@ void propagate_values::reduce() {
         m_rewriter.reset();
         m_rewriter.set_substitution(&m_subst);
         for (unsigned i = 0; i < qhead(); ++i)
-            add_sub(m_fmls[i]);
+            add_sub(m_fmls[i], true);
     };
     
     unsigned rw = m_stats.m_num_rewrites + 1;
@@ -39,7 +39,8 @@ class propagate_values : public dependent_expr_simplifier {
     expr_substitution      m_subst;
 
     void process_fml(unsigned i);
-    void add_sub(dependent_expr const& de);
+    void add_sub(dependent_expr const& de, bool in_prefix);
+    bool is_shared(expr* e, bool in_prefix) { return in_prefix || m_shared.is_shared(e); }
 
 public:
     propagate_values(ast_manager& m, params_ref const& p, dependent_expr_state& fmls);
@@ -37,8 +37,25 @@ template <typename T>
 std::ostream& operator<<(std::ostream& out, const row_cell<T>& rc) {
     return out << "(j=" << rc.var() << ", offset= " << rc.offset() << ", coeff=" << rc.coeff() << ")";   
 }
-struct empty_struct {};
-typedef row_cell<empty_struct> column_cell;
+// A column cell only points back into a row; the coefficient is stored in the row cell.
+// It is kept separate from row_cell so that a column entry occupies exactly two words.
+class column_cell {
+    unsigned m_i;         // points to the row
+    unsigned m_offset;    // offset in row
+public:
+    column_cell(unsigned i, unsigned offset) : m_i(i), m_offset(offset) {
+    }
+    inline unsigned var() const { return m_i; }
+    inline unsigned & var() { return m_i; }
+    inline unsigned offset() const { return m_offset; }
+    inline unsigned & offset() { return m_offset; }
+};
+
+inline std::ostream& operator<<(std::ostream& out, const column_cell& cc) {
+    return out << "(i=" << cc.var() << ", offset= " << cc.offset() << ")";
+}
+static_assert(sizeof(column_cell) == 2 * sizeof(unsigned), "column cells should be packed");
+
 typedef std_vector<column_cell> column_strip;
 
 template <typename T>
@@ -77,8 +77,8 @@ namespace lp {
             m_work_vector_of_row_offsets[rowii[k].var()] = -1;
         }
 
-        // remove zeroes
-        for (unsigned k = static_cast<unsigned>(rowii.size()); k-- > 0;  ) {
+        // remove zeroes: cells appended past prev_size_ii are products of non-zeroes
+        for (unsigned k = prev_size_ii; k-- > 0;  ) {
             if (is_zero(rowii[k].coeff()))
                 remove_element(rowii, rowii[k]);
         }
@@ -146,8 +146,8 @@ namespace lp {
             m_work_vector_of_row_offsets[rowii[k].var()] = -1;
         }
 
-        // remove zeroes
-        for (unsigned k = static_cast<unsigned>(rowii.size()); k-- > 0;  ) {
+        // remove zeroes: cells appended past prev_size_ii are products of non-zeroes
+        for (unsigned k = prev_size_ii; k-- > 0;  ) {
             if (is_zero(rowii[k].coeff()))
                 remove_element(rowii, rowii[k]);
         }
@@ -215,8 +215,8 @@ namespace lp {
             m_work_vector_of_row_offsets[rowii[k].var()] = -1;
         }
 
-        // remove zeroes
-        for (unsigned k = static_cast<unsigned>(rowii.size()); k-- > 0;  ) {
+        // remove zeroes: cells appended past prev_size_ii are products of non-zeroes
+        for (unsigned k = prev_size_ii; k-- > 0;  ) {
             if (is_zero(rowii[k].coeff()))
                 remove_element(rowii, rowii[k]);
         }
@@ -27,11 +27,15 @@ Revision History:
 #include "ast/rewriter/var_subst.h"
 #include "ast/has_free_vars.h"
 #include "ast/ast_smt2_pp.h"
+#include "ast/ast_translation.h"
 #include "parsers/smt2/smt2parser.h"
 #include "parsers/smt2/smt2scanner.h"
 #include "parsers/util/pattern_validation.h"
 #include "parsers/util/parser_params.hpp"
 #include<sstream>
+#ifndef SINGLE_THREAD
+#include<thread>
+#endif
 
 namespace smt2 {
     typedef cmd_exception parser_exception;
@@ -3134,6 +3138,11 @@ namespace smt2 {
             m_scanner.reset_input(is, interactive);
         }
 
+        void reset_input(std::istream & is, bool interactive, unsigned line) {
+            m_scanner.set_line(line);
+            m_scanner.reset_input(is, interactive);
+        }
+
         sexpr_ref parse_sexpr_ref() {
             m_num_bindings    = 0;
             m_num_open_paren = 0;
@@ -3235,9 +3244,358 @@ namespace smt2 {
     };
 
     void free_parser(parser * p) { dealloc(p); }
+
+    /**
+       \brief Parse a script where runs of assertions are parsed in parallel.
+
+       The script is split at top-level commands. Long runs of assertions
+       that follow only declarations, definitions and commands that do not
+       change the signature are distributed over worker contexts. Each
+       worker owns a private manager and replays the declarations seen so
+       far before it parses its share of the run. The parsed assertions are
+       translated back and asserted in order. Workers are created again after
+       set-option and set-logic, and they copy the options of the context
+       that affect parsing, such as int-real-coercions.
+
+       A run is parsed again sequentially when a worker fails, and
+       parallel parsing is disabled for the rest of the script. Commands
+       such as push/pop, datatype declarations and named assertions end
+       parallel parsing, the remaining script is parsed sequentially.
+    */
+    class parallel_parser {
+
+        // STATE_CMD changes options or the logic of the context, workers
+        // are created again after it so that they start from the new state.
+        enum cmd_kind { ASSERT_CMD, DECL_CMD, NEUTRAL_CMD, STATE_CMD, OTHER_CMD };
+
+        struct command {
+            size_t   m_begin;   // start of the blanks and comments preceding the command
+            size_t   m_end;     // one past the closing parenthesis
+            cmd_kind m_kind;
+        };
+
+        // input stream over a range of the script.
+        class range_buf : public std::streambuf {
+        public:
+            range_buf(char const * b, char const * e) {
+                char * p = const_cast<char *>(b);
+                setg(p, p, const_cast<char *>(e));
+            }
+        };
+
+        // parser that is reused for consecutive ranges of the script.
+        class range_parser {
+            std::istringstream m_empty;
+            parser             m_parser;
+        public:
+            range_parser(cmd_context & ctx, params_ref const & ps, char const * filename):
+                m_parser(ctx, m_empty, false, ps, filename) {}
+
+            bool operator()(char const * b, char const * e, unsigned line) {
+                range_buf buf(b, e);
+                std::istream is(&buf);
+                m_parser.reset_input(is, false, line);
+                return m_parser();
+            }
+        };
+
+        struct worker {
+            std::ostringstream      m_out;
+            scoped_ptr<ast_manager> m_manager;
+            scoped_ptr<cmd_context> m_ctx;
+            scoped_ptr<range_parser> m_parser;
+            unsigned                m_num_decls = 0;   // number of declaration ranges replayed
+            size_t                  m_begin = 0, m_end = 0;
+            bool                    m_ok = true;
+        };
+
+        static const unsigned min_run = 64;
+
+        cmd_context &                   m_ctx;
+        params_ref                      m_params;
+        char const *                    m_filename;
+        unsigned                        m_num_threads;
+        std::string                     m_input;
+        svector<command>                m_cmds;
+        svector<std::pair<size_t, size_t>> m_decls;
+        range_parser                    m_parser;
+        scoped_ptr_vector<worker>       m_workers;
+        bool                            m_parallel = true;
+        size_t                          m_line_pos = 0;
+        unsigned                        m_line = 1;
+
+        static bool is_delimiter(char c) {
+            return c == '(' || c == ')' || c == ';' || c == '"' || c == '|' || isspace(static_cast<unsigned char>(c));
+        }
+
+        void skip_blanks(size_t & i) const {
+            size_t n = m_input.size();
+            while (i < n) {
+                char c = m_input[i];
+                if (c == ';') {
+                    while (i < n && m_input[i] != '\n')
+                        ++i;
+                }
+                else if (isspace(static_cast<unsigned char>(c)))
+                    ++i;
+                else
+                    break;
+            }
+        }
+
+        // move i past the command starting at i. Return false if it is not terminated.
+        bool skip_command(size_t & i, bool & named) const {
+            SASSERT(m_input[i] == '(');
+            size_t n = m_input.size();
+            unsigned depth = 0;
+            while (i < n) {
+                char c = m_input[i++];
+                switch (c) {
+                case '(':
+                    ++depth;
+                    break;
+                case ')':
+                    if (--depth == 0)
+                        return true;
+                    break;
+                case ';':
+                    while (i < n && m_input[i] != '\n')
+                        ++i;
+                    break;
+                case '"':
+                    // "" is an escaped quote
+                    while (i < n && (m_input[i] != '"' || (i + 1 < n && m_input[i + 1] == '"')))
+                        i += m_input[i] == '"' ? 2 : 1;
+                    if (i == n)
+                        return false;
+                    ++i;
+                    break;
+                case '|':
+                    while (i < n && m_input[i] != '|')
+                        i += m_input[i] == '\\' ? 2 : 1;
+                    if (i >= n)
+                        return false;
+                    ++i;
+                    break;
+                case ':':
+                    named |= m_input.compare(i, 5, "named") == 0;
+                    break;
+                default:
+                    break;
+                }
+            }
+            return false;
+        }
+
+        static cmd_kind classify(std::string const & name, bool named) {
+            static char const * const decls[] = {
+                "declare-fun", "declare-const", "declare-sort", "define-sort", "define-fun", "define-const" };
+            static char const * const neutral[] = {
+                "set-info", "check-sat", "check-sat-assuming", "echo",
+                "get-model", "get-value", "get-info", "get-option", "get-assertions", "get-unsat-core", "get-proof" };
+            if (name == "assert")
+                return named ? OTHER_CMD : ASSERT_CMD;
+            for (char const * d : decls)
+                if (name == d)
+                    return DECL_CMD;
+            for (char const * d : neutral)
+                if (name == d)
+                    return NEUTRAL_CMD;
+            if (name == "set-option" || name == "set-logic")
+                return STATE_CMD;
+            return OTHER_CMD;
+        }
+
+        void split() {
+            size_t n = m_input.size(), i = 0;
+            while (true) {
+                size_t begin = i;
+                skip_blanks(i);
+                if (i == n || m_input[i] != '(')
+                    return;
+                size_t j = i + 1;
+                skip_blanks(j);
+                size_t k = j;
+                while (k < n && !is_delimiter(m_input[k]))
+                    ++k;
+                std::string name = m_input.substr(j, k - j);
+                bool named = false;
+                if (!skip_command(i, named))
+                    return;
+                cmd_kind kind = classify(name, named);
+                if (kind == OTHER_CMD)
+                    return;
+                m_cmds.push_back({ begin, i, kind });
+            }
+        }
+
+        unsigned line_of(size_t pos) {
+            SASSERT(m_line_pos <= pos);
+            for (; m_line_pos < pos; ++m_line_pos)
+                if (m_input[m_line_pos] == '\n')
+                    ++m_line;
+            return m_line;
+        }
+
+        bool parse_sequential(size_t b, size_t e) {
+            if (b == e)
+                return true;
+            return m_parser(m_input.data() + b, m_input.data() + e, line_of(b));
+        }
+
+        bool run_worker(worker & w) {
+            char const * s = m_input.data();
+            for (; w.m_num_decls < m_decls.size(); ++w.m_num_decls) {
+                auto [b, e] = m_decls[w.m_num_decls];
+                if (!(*w.m_parser)(s + b, s + e, 1))
+                    return false;
+            }
+            return (*w.m_parser)(s + w.m_begin, s + w.m_end, 1);
+        }
+
+        /**
+           \brief parse the assertions m_cmds[i], .., m_cmds[j - 1] in parallel.
+           Return false if the assertions have to be parsed sequentially.
+        */
+        bool parse_parallel(unsigned i, unsigned j) {
+#ifdef SINGLE_THREAD
+            return false;
+#else
+            ast_manager & m = m_ctx.m();
+            if (m_ctx.interactive_mode() || m.has_trace_stream()) {
+                m_parallel = false;
+                return false;
+            }
+            unsigned num_threads = std::min(m_num_threads, j - i);
+            while (m_workers.size() < num_threads) {
+                worker * w = alloc(worker);
+                m_workers.push_back(w);
+                w->m_manager = alloc(ast_manager, m, true);
+                w->m_ctx = alloc(cmd_context, false, w->m_manager.get());
+                w->m_manager->enable_int_real_coercions(m.int_real_coercions());
+                if (m_ctx.has_logic())
+                    w->m_ctx->set_logic(m_ctx.get_logic());
+                w->m_ctx->set_numeral_as_real(m_ctx.numeral_as_real());
+                w->m_ctx->set_regular_stream(w->m_out);
+                w->m_ctx->set_diagnostic_stream(w->m_out);
+                w->m_parser = alloc(range_parser, *w->m_ctx, m_params, m_filename);
+            }
+
+            // split the run into contiguous ranges of roughly the same size.
+            size_t begin = m_cmds[i].m_begin, end = m_cmds[j - 1].m_end;
+            unsigned k = i;
+            for (unsigned t = 0; t < num_threads; ++t) {
+                worker & w = *m_workers[t];
+                size_t target = begin + ((end - begin) / num_threads) * (t + 1);
+                unsigned k0 = k;
+                w.m_begin = k < j ? m_cmds[k].m_begin : end;
+                while (k < j && (m_cmds[k].m_end <= target || t + 1 == num_threads))
+                    ++k;
+                w.m_end = k == k0 ? w.m_begin : m_cmds[k - 1].m_end;
+                w.m_ok = true;
+            }
+
+            scoped_limits sl(m.limit());
+            for (unsigned t = 0; t < num_threads; ++t)
+                sl.push_child(&(m_workers[t]->m_manager->limit()));
+
+            auto work = [&](worker & w) {
+                try {
+                    w.m_ok = run_worker(w);
+                }
+                catch (z3_exception &) {
+                    w.m_ok = false;
+                }
+            };
+            vector<std::thread> threads;
+            for (unsigned t = 0; t < num_threads; ++t)
+                threads.push_back(std::thread([&, t]() { work(*m_workers[t]); }));
+            for (auto & th : threads)
+                th.join();
+
+            bool ok = true;
+            for (unsigned t = 0; t < num_threads; ++t)
+                ok &= m_workers[t]->m_ok;
+            IF_VERBOSE(10, verbose_stream() << "(smt2-parallel-parse :assertions " << (j - i) << " :threads " << num_threads << " :ok " << ok << ")\n");
+            if (!ok) {
+                m_parallel = false;
+                return false;
+            }
+
+            for (unsigned t = 0; t < num_threads; ++t) {
+                cmd_context & wctx = *m_workers[t]->m_ctx;
+                ast_translation tr(wctx.m(), m);
+                for (expr * a : wctx.assertions()) {
+                    m_ctx.assert_expr(tr(a));
+                    m_ctx.print_success();
+                }
+                wctx.reset_assertions();
+            }
+            return true;
+#endif
+        }
+
+    public:
+        parallel_parser(cmd_context & ctx, std::istream & is, params_ref const & ps, char const * filename, unsigned num_threads):
+            m_ctx(ctx),
+            m_params(ps),
+            m_filename(filename),
+            m_num_threads(num_threads),
+            m_parser(ctx, ps, filename) {
+            std::ostringstream buffer;
+            buffer << is.rdbuf();
+            m_input = std::move(buffer).str();
+        }
+
+        bool operator()() {
+            split();
+            bool ok = true;
+            size_t pending = 0;     // start of the commands that are not parsed yet
+            for (unsigned i = 0; i < m_cmds.size() && m_parallel; ) {
+                command const & c = m_cmds[i];
+                if (c.m_kind != ASSERT_CMD) {
+                    if (c.m_kind == STATE_CMD)
+                        m_workers.reset();
+                    else if (c.m_kind != DECL_CMD)
+                        ;
+                    else if (!m_decls.empty() && m_decls.back().second == c.m_begin)
+                        m_decls.back().second = c.m_end;
+                    else
+                        m_decls.push_back({ c.m_begin, c.m_end });
+                    ++i;
+                    continue;
+                }
+                unsigned j = i;
+                while (j < m_cmds.size() && m_cmds[j].m_kind == ASSERT_CMD)
+                    ++j;
+                if (j - i >= min_run) {
+                    size_t end = m_cmds[j - 1].m_end;
+                    ok &= parse_sequential(pending, c.m_begin);
+                    try {
+                        if (!parse_parallel(i, j))
+                            ok &= parse_sequential(c.m_begin, end);
+                    }
+                    catch (z3_exception & ex) {
+                        m_ctx.regular_stream() << "(error \"" << ex.what() << "\")" << std::endl;
+                        m_parallel = false;
+                        ok = false;
+                    }
+                    pending = end;
+                }
+                i = j;
+            }
+            ok &= parse_sequential(pending, m_input.size());
+            return ok;
+        }
+    };
 };
 
 bool parse_smt2_commands(cmd_context & ctx, std::istream & is, bool interactive, params_ref const & ps, char const * filename) {
+    unsigned num_threads = parser_params(ps).threads();
+    if (!interactive && num_threads > 1) {
+        smt2::parallel_parser p(ctx, is, ps, filename, num_threads);
+        return p();
+    }
     smt2::parser p(ctx, is, interactive, ps, filename);
     return p();
 }
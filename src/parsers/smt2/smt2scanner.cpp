@@ -18,6 +18,7 @@ Revision History:
 --*/
 #include "parsers/smt2/smt2scanner.h"
 #include "parsers/util/parser_params.hpp"
+#include <cstring>
 
 namespace smt2 {
 
@@ -50,9 +51,38 @@ namespace smt2 {
         m_spos++;
     }
 
+    /**
+       \brief Consume the characters in m_buffer before position j and
+       make m_buffer[j] the current character. Equivalent to calling next()
+       j - m_bpos + 1 times, without the per character overhead.
+    */
+    void scanner::skip_to(unsigned j) {
+        SASSERT(is_buffered());
+        SASSERT(m_bpos <= j && j <= m_bend);
+        m_spos += j - m_bpos;
+        m_bpos = j;
+        next();
+    }
+
+    void scanner::skip_blanks() {
+        if (!is_buffered()) {
+            next();
+            return;
+        }
+        unsigned j = m_bpos;
+        while (j < m_bend && m_normalized[static_cast<unsigned char>(m_buffer[j])] == ' ')
+            ++j;
+        skip_to(j);
+    }
+
     void scanner::read_comment() {
         SASSERT(curr() == ';');
         next();
+        while (is_buffered() && curr() != '\n') {
+            // memchr is vectorized by the C library.
+            char const* nl = static_cast<char const*>(memchr(m_buffer + m_bpos, '\n', m_bend - m_bpos));
+            skip_to(nl ? static_cast<unsigned>(nl - m_buffer) : m_bend);
+        }
         while (true) {
             char c = curr();
             if (m_at_eof)
@@ -123,6 +153,17 @@ namespace smt2 {
             signed char n = m_normalized[static_cast<unsigned char>(c)];
             if (n == 'a' || n == '0' || n == '-') {
                 m_string.push_back(c);
+                if (is_buffered()) {
+                    unsigned j = m_bpos;
+                    while (j < m_bend && is_symbol_char(m_buffer[j]))
+                        ++j;
+                    m_string.append(j - m_bpos, m_buffer + m_bpos);
+                    if (j > m_bpos) {
+                        m_spos += j - m_bpos;
+                        m_bpos = j;
+                        m_curr = m_buffer[j - 1];
+                    }
+                }
                 next();
             }
             else {
@@ -150,17 +191,27 @@ namespace smt2 {
 
     scanner::token scanner::read_number() {
         SASSERT('0' <= curr() && curr() <= '9');
-        rational q(1);
-        m_number = rational(curr() - '0');
+        // digits are accumulated in acc and moved to m_number before acc can overflow.
+        uint64_t acc = curr() - '0', scale = 10;
+        unsigned num_decimals = 0;
+        m_number = rational::zero();
+        auto flush = [&]() {
+            m_number = m_number * rational(scale, rational::ui64()) + rational(acc, rational::ui64());
+            acc = 0;
+            scale = 1;
+        };
         next();
         bool is_float = false;
 
         while (!m_at_eof) {
             char c = curr();
             if ('0' <= c && c <= '9') {
-                m_number = rational(10)*m_number + rational(c - '0');
+                if (scale >= 1000000000000000000ull)
+                    flush();
+                acc = 10 * acc + (c - '0');
+                scale *= 10;
                 if (is_float)
-                    q *= rational(10);
+                    ++num_decimals;
                 next();
             }
             else if (c == '.') {
@@ -173,8 +224,9 @@ namespace smt2 {
                 break;
             }
         }
+        flush();
         if (is_float)
-            m_number /= q;
+            m_number /= power(rational(10), num_decimals);
         TRACE("scanner", tout << "new number: " << m_number << "\n";);
         return is_float ? FLOAT_TOKEN : INT_TOKEN;
     }
@@ -340,7 +392,7 @@ namespace smt2 {
 
             switch (m_normalized[(unsigned char) c]) {
             case ' ':
-                next();
+                skip_blanks();
                 break;
             case '\n':
                 next();
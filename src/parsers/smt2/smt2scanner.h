@@ -44,7 +44,7 @@ namespace smt2 {
         unsigned           m_bv_size;
         // end of data
         signed char        m_normalized[256];
-#define SCANNER_BUFFER_SIZE 1024
+#define SCANNER_BUFFER_SIZE 16384
         char               m_buffer[SCANNER_BUFFER_SIZE];
         unsigned           m_bpos;
         unsigned           m_bend;
@@ -59,6 +59,15 @@ namespace smt2 {
         char curr() const { return m_curr; }
         void new_line() { m_line++; m_spos = 0; }
         void next();
+
+        // characters following the current one can be consumed directly from m_buffer.
+        bool is_buffered() const { return !m_interactive && !m_cache_input && !m_at_eof; }
+        bool is_symbol_char(char c) const {
+            signed char n = m_normalized[static_cast<unsigned char>(c)];
+            return n == 'a' || n == '0' || n == '-';
+        }
+        void skip_to(unsigned j);
+        void skip_blanks();
         
     public:
         
@@ -78,6 +87,7 @@ namespace smt2 {
         scanner(cmd_context & ctx, std::istream& stream, bool interactive = false);  
         
         int get_line() const { return m_line; }
+        void set_line(int line) { m_line = line; m_spos = 0; }
         int get_pos() const { return m_pos; }
         symbol const & get_id() const { return m_id; }
         rational get_number() const { return m_number; }
@@ -96,6 +96,9 @@ namespace sat {
         
         m_max_conflicts   = p.max_conflicts();
         m_num_threads     = p.threads();
+        m_par_max_glue    = p.par_max_glue();
+        m_par_max_size    = p.par_max_size();
+        m_par_import_interval = p.par_import_interval();
         m_ddfw_search     = p.ddfw_search();
         m_ddfw_threads    = p.ddfw_threads();
         m_prob_search     = p.prob_search();
@@ -177,6 +180,8 @@ namespace sat {
             m_gc_strategy = GC_PSM;
         else if (s == symbol("psm_glue"))
             m_gc_strategy = GC_PSM_GLUE;
+        else if (s == symbol("tiered"))
+            m_gc_strategy = GC_TIERED;
         else 
             throw sat_param_exception("invalid gc strategy");
         m_gc_initial      = p.gc_initial();
@@ -185,6 +190,10 @@ namespace sat {
         m_gc_k            = std::min(255u, p.gc_k());
         m_gc_burst        = p.gc_burst();
         m_gc_defrag       = p.gc_defrag();
+        m_gc_tier1_glue   = p.gc_tier1_glue();
+        m_gc_tier2_glue   = p.gc_tier2_glue();
+        // inactive rounds are counted in 8 bits, and a clause is demoted after m_gc_tier2_rounds + 1 of them.
+        m_gc_tier2_rounds = std::min(254u, p.gc_tier2_rounds());
 
         m_force_cleanup   = p.force_cleanup();
 
@@ -45,7 +45,8 @@ namespace sat {
         GC_PSM,
         GC_GLUE,
         GC_GLUE_PSM,
-        GC_PSM_GLUE
+        GC_PSM_GLUE,
+        GC_TIERED
     };
 
     enum branching_heuristic {
@@ -112,6 +113,9 @@ namespace sat {
         bool               m_enable_pre_simplify;
         unsigned           m_max_conflicts;
         unsigned           m_num_threads;
+        unsigned           m_par_max_glue;
+        unsigned           m_par_max_size;
+        unsigned           m_par_import_interval;
         bool               m_ddfw_search;
         unsigned           m_ddfw_threads;
         bool               m_prob_search;
@@ -161,6 +165,9 @@ namespace sat {
         unsigned           m_gc_k;
         bool               m_gc_burst;
         bool               m_gc_defrag;
+        unsigned           m_gc_tier1_glue;
+        unsigned           m_gc_tier2_glue;
+        unsigned           m_gc_tier2_rounds;
 
         bool               m_force_cleanup;
 
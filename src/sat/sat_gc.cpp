@@ -55,6 +55,9 @@ namespace sat {
         case GC_PSM_GLUE:
             gc_psm_glue();
             break;
+        case GC_TIERED:
+            gc_tiered();
+            break;
         case GC_DYN_PSM:
             if (!m_assumptions.empty()) {
                 gc_glue_psm();
@@ -144,6 +147,67 @@ namespace sat {
         gc_half("psm-glue");
     }
 
+    /**
+       \brief Three tier gc.
+       Clauses with glue at most gc.tier1_glue form the core tier and are kept.
+       Clauses with glue at most gc.tier2_glue are kept as long as they were used
+       during the last gc.tier2_rounds rounds. Glue is updated during propagation,
+       so clauses are promoted when their glue drops.
+       Only the remaining local clauses are sorted and the worse half of them is deleted.
+       Local clauses used since the last round are spared once.
+    */
+    void solver::gc_tiered() {
+        TRACE("sat", tout << "gc\n";);
+        unsigned sz = m_learned.size();
+        unsigned num_core = 0, num_tier2 = 0, num_demoted = 0;
+        clause_vector& local = m_gc_local;
+        local.reset();
+        unsigned j = 0;
+        for (clause* cp : m_learned) {
+            clause& c = *cp;
+            bool used = c.was_used();
+            c.unmark_used();
+            if (c.frozen() || c.glue() <= m_config.m_gc_tier1_glue) {
+                ++num_core;
+                m_learned[j++] = cp;
+                continue;
+            }
+            if (c.glue() <= m_config.m_gc_tier2_glue) {
+                if (used)
+                    c.reset_inact_rounds();
+                else if (c.inact_rounds() <= m_config.m_gc_tier2_rounds)
+                    c.inc_inact_rounds();
+                if (c.inact_rounds() <= m_config.m_gc_tier2_rounds) {
+                    ++num_tier2;
+                    m_learned[j++] = cp;
+                    continue;
+                }
+                ++num_demoted;
+            }
+            else if (used) {
+                m_learned[j++] = cp;
+                continue;
+            }
+            local.push_back(cp);
+        }
+        std::stable_sort(local.begin(), local.end(), glue_lt());
+        unsigned half = local.size() / 2;
+        for (unsigned i = 0; i < local.size(); ++i) {
+            clause& c = *local[i];
+            if (i >= half && can_delete(c)) {
+                detach_clause(c);
+                del_clause(c);
+            }
+            else
+                m_learned[j++] = &c;
+        }
+        m_learned.shrink(j);
+        local.reset();
+        m_stats.m_gc_clause += sz - j;
+        IF_VERBOSE(SAT_VB_LVL, verbose_stream() << "(sat-gc :strategy tiered :core " << num_core << " :tier2 " << num_tier2
+                   << " :demoted " << num_demoted << " :deleted " << (sz - j) << ")\n";);
+    }
+
     /**
        \brief Compute the psm of all learned clauses.
     */
@@ -0,0 +1,477 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_inprocess.cpp
+
+Abstract:
+
+    Tick based scheduler for inprocessing.
+
+Author:
+
+    agent 2026-10-17
+
+--*/
+
+#include "sat/sat_inprocess.h"
+#include "sat/sat_solver.h"
+#include "params/sat_params.hpp"
+
+namespace sat {
+
+    bool inprocess::technique::should_run() {
+        if (m_effort == 0)
+            return false;
+        if (m_delay > 0) {
+            --m_delay;
+            ++m_skipped;
+            return false;
+        }
+        return true;
+    }
+
+    void inprocess::technique::update(unsigned yield) {
+        ++m_rounds;
+        m_yield += yield;
+        if (yield == 0)
+            m_backoff = std::min(2 * m_backoff + 1, 32u);
+        else
+            m_backoff /= 2;
+        m_delay = m_backoff;
+    }
+
+    inprocess::inprocess(solver& s, params_ref const& p):
+        s(s) {
+        updt_params(p);
+    }
+
+    void inprocess::updt_params(params_ref const& _p) {
+        sat_params p(_p);
+        m_enabled          = p.inprocess_schedule();
+        m_vivify.m_effort  = p.inprocess_vivify_effort();
+        m_bva.m_effort     = p.inprocess_bva_effort();
+        m_bve.m_effort     = p.inprocess_bve_effort();
+        m_vivify_glue      = p.inprocess_vivify_glue();
+    }
+
+    uint64_t inprocess::budget(technique const& t, uint64_t search_ticks) const {
+        return std::max(static_cast<uint64_t>(m_min_budget), (search_ticks * t.m_effort) / 1000);
+    }
+
+    /**
+       \brief run one round of scheduled inprocessing.
+       It replaces the non-learned pass of the simplifier in solver::do_simplify.
+    */
+    void inprocess::operator()() {
+        SASSERT(s.at_base_lvl());
+        ++m_rounds;
+        uint64_t search_ticks = m_ticks - m_last_ticks;
+        unsigned bve_yield = 0, bva_yield = 0, vivify_yield = 0;
+        uint64_t ticks = 0;
+
+        // subsumption and blocked clause elimination run every round.
+        // variable elimination only gets a budget when it is scheduled.
+        bool run_bve = m_bve.should_run();
+        bve_yield = bve(run_bve ? budget(m_bve, search_ticks) : 0, ticks);
+        if (run_bve) {
+            m_bve.m_ticks += ticks;
+            m_bve.update(bve_yield);
+        }
+
+        if (!s.inconsistent() && bva_enabled() && m_bva.should_run()) {
+            uint64_t t0 = m_ticks;
+            bva_yield = bva(budget(m_bva, search_ticks));
+            m_bva.m_ticks += m_ticks - t0;
+            m_bva.update(bva_yield);
+        }
+
+        if (!s.inconsistent() && m_vivify.should_run()) {
+            uint64_t t0 = m_ticks;
+            vivify_yield = vivify(budget(m_vivify, search_ticks));
+            m_vivify.m_ticks += m_ticks - t0;
+            m_vivify.update(vivify_yield);
+        }
+
+        IF_VERBOSE(2, verbose_stream() << "(sat.inprocess :search-ticks " << search_ticks
+                   << " :bve " << bve_yield << " :bva " << bva_yield << " :vivify " << vivify_yield << ")\n";);
+        m_last_ticks = m_ticks;
+    }
+
+    // ------------------------------------
+    // vivification of learned clauses
+
+    unsigned inprocess::vivify(uint64_t budget) {
+        s.propagate(false);
+        if (s.inconsistent())
+            return 0;
+        uint64_t limit = m_ticks + budget;
+        unsigned elim = 0;
+        bool_vector saved_phase(s.m_phase);
+        flet<bool> _is_probing(s.m_is_probing, true);
+        clause_vector& clauses = s.m_learned;
+        std::stable_sort(clauses.begin(), clauses.end(), [](clause const* a, clause const* b) { return a->glue() < b->glue(); });
+        auto it = clauses.begin(), it2 = it, end = clauses.end();
+        try {
+            for (; it != end; ++it) {
+                clause& c = *(*it);
+                if (s.inconsistent() || m_ticks > limit || c.glue() > m_vivify_glue || c.frozen() || c.was_removed()) {
+                    *it2 = *it;
+                    ++it2;
+                    continue;
+                }
+                s.checkpoint();
+                unsigned sz = c.size();
+                bool keep = vivify(c);
+                if (keep) {
+                    elim += sz - c.size();
+                    *it2 = *it;
+                    ++it2;
+                }
+                else
+                    elim += sz;
+            }
+            clauses.set_end(it2);
+        }
+        catch (solver_exception&) {
+            for (; it != end; ++it, ++it2)
+                *it2 = *it;
+            clauses.set_end(it2);
+            s.m_phase = saved_phase;
+            throw;
+        }
+        s.m_phase = saved_phase;
+        s.propagate(false);
+        return elim;
+    }
+
+    /**
+       \brief assign the negation of the literals in c one by one and propagate.
+       The clause is shortened to the prefix that leads to a conflict or
+       to a literal that is implied true. Literals that are implied false
+       are removed.
+       Return false if c was deleted.
+    */
+    bool inprocess::vivify(clause& c) {
+        SASSERT(s.at_base_lvl());
+        for (literal lit : c) {
+            if (s.value(lit) == l_true) {
+                s.detach_clause(c);
+                s.del_clause(c);
+                return false;
+            }
+        }
+        scoped_detach scoped_d(s, c);
+        unsigned sz = c.size();
+        m_lits.reset();
+        s.push();
+        for (unsigned i = 0; i < sz; ++i) {
+            literal lit = c[i];
+            lbool val = s.value(lit);
+            if (val == l_false)
+                continue;
+            m_lits.push_back(lit);
+            if (val == l_true)
+                break;
+            s.assign_scoped(~lit);
+            s.propagate_core(false);
+            if (s.inconsistent())
+                break;
+        }
+        s.pop(1);
+        unsigned new_sz = m_lits.size();
+        if (new_sz == sz)
+            return true;
+
+        // move the retained literals to the front, preserving the removed literals for proof logging.
+        for (unsigned i = 0, j = 0; i < sz && j < new_sz; ++i) {
+            if (c[i] == m_lits[j]) {
+                std::swap(c[i], c[j]);
+                ++j;
+            }
+        }
+        TRACE("sat", tout << "vivified " << c << " to " << m_lits << "\n";);
+        VERIFY(s.m_trail.size() == s.m_qhead);
+        switch (new_sz) {
+        case 0:
+            s.set_conflict();
+            return true;
+        case 1:
+            s.assign_unit(c[0]);
+            s.propagate_core(false);
+            scoped_d.del_clause();
+            return false;
+        case 2:
+            s.mk_bin_clause(c[0], c[1], c.is_learned());
+            if (s.m_trail.size() > s.m_qhead) s.propagate_core(false);
+            scoped_d.del_clause();
+            return false;
+        default:
+            s.shrink(c, sz, new_sz);
+            if (c.glue() > new_sz)
+                c.set_glue(new_sz);
+            return true;
+        }
+    }
+
+    // ------------------------------------
+    // bounded variable addition
+    //
+    // Clauses l_i \/ C_j for i = 1..n, j = 1..m are replaced by
+    // ~x \/ l_i and x \/ C_j for a fresh variable x,
+    // which removes n*m clauses and adds n + m clauses.
+    //
+
+    bool inprocess::bva_enabled() const {
+        return
+            !s.m_ext &&
+            !s.m_config.m_drat &&
+            !s.tracking_assumptions() &&
+            s.num_user_scopes() == 0;
+    }
+
+    void inprocess::init_occs() {
+        m_occs.reset();
+        m_occs.resize(2 * s.num_vars());
+        m_marked.reset();
+        m_marked.resize(2 * s.num_vars(), false);
+        m_stamp.reset();
+        m_stamp.resize(2 * s.num_vars(), 0);
+        m_count.reset();
+        m_count.resize(2 * s.num_vars(), 0);
+        for (clause* c : s.m_clauses)
+            if (!c->was_removed() && c->size() >= 3)
+                add_occ(*c);
+    }
+
+    void inprocess::add_occ(clause& c) {
+        for (literal lit : c)
+            m_occs[lit.index()].push_back(&c);
+    }
+
+    literal inprocess::min_occ(clause const& c, literal l) const {
+        literal result = null_literal;
+        for (literal lit : c)
+            if (lit != l && (result == null_literal || m_occs[lit.index()].size() < m_occs[result.index()].size()))
+                result = lit;
+        return result;
+    }
+
+    /**
+       \brief find the clause (c \ { l }) \/ m
+    */
+    clause* inprocess::find_partner(clause& c, literal l, literal m) {
+        if (l == m)
+            return &c;
+        for (literal lit : c)
+            m_marked[lit.index()] = true;
+        clause* result = nullptr;
+        for (clause* d : m_occs[m.index()]) {
+            if (d->was_removed() || d->size() != c.size())
+                continue;
+            unsigned num_marked = 0;
+            for (literal lit : *d)
+                if (m_marked[lit.index()] && lit != l)
+                    ++num_marked;
+            if (num_marked + 1 == c.size()) {
+                result = d;
+                break;
+            }
+        }
+        for (literal lit : c)
+            m_marked[lit.index()] = false;
+        return result;
+    }
+
+    void inprocess::remove(clause& c) {
+        s.detach_clause(c);
+        c.set_removed(true);
+    }
+
+    static int bva_reduction(unsigned num_lits, unsigned num_cls) {
+        return static_cast<int>(num_lits * num_cls) - static_cast<int>(num_lits + num_cls);
+    }
+
+    /**
+       \brief SimpleBVA: grow a set of literals l_1 .. l_n and clauses C_1 .. C_m
+       such that l_i \/ C_j are all present, as long as the reduction increases.
+    */
+    bool inprocess::bva(literal l, uint64_t& ticks) {
+        m_bva_lits.reset();
+        m_bva_cls.reset();
+        m_bva_lits.push_back(l);
+        for (clause* c : m_occs[l.index()])
+            if (!c->was_removed())
+                m_bva_cls.push_back(c);
+        if (m_bva_cls.size() < 2)
+            return false;
+        while (true) {
+            m_matches.reset();
+            unsigned idx = 0;
+            for (clause* c : m_bva_cls) {
+                ++idx;
+                literal lmin = min_occ(*c, l);
+                for (literal lit : *c)
+                    m_marked[lit.index()] = true;
+                for (clause* d : m_occs[lmin.index()]) {
+                    ticks += d->size();
+                    if (d == c || d->was_removed() || d->size() != c->size())
+                        continue;
+                    literal diff = null_literal;
+                    unsigned num_diff = 0;
+                    for (literal lit : *d) {
+                        if (!m_marked[lit.index()]) {
+                            diff = lit;
+                            ++num_diff;
+                        }
+                        else if (lit == l)
+                            num_diff = 2;
+                    }
+                    if (num_diff != 1 || m_bva_lits.contains(diff) || m_stamp[diff.index()] == idx)
+                        continue;
+                    m_stamp[diff.index()] = idx;
+                    m_matches.push_back({ diff, c });
+                }
+                for (literal lit : *c)
+                    m_marked[lit.index()] = false;
+            }
+            for (auto const& [lit, c] : m_matches)
+                m_stamp[lit.index()] = 0;
+            if (m_matches.empty())
+                break;
+            literal best = null_literal;
+            for (auto const& [lit, c] : m_matches) {
+                m_count[lit.index()]++;
+                if (best == null_literal || m_count[lit.index()] > m_count[best.index()])
+                    best = lit;
+            }
+            unsigned num_best = m_count[best.index()];
+            for (auto const& [lit, c] : m_matches)
+                m_count[lit.index()] = 0;
+            if (bva_reduction(m_bva_lits.size() + 1, num_best) <= bva_reduction(m_bva_lits.size(), m_bva_cls.size()))
+                break;
+            m_bva_lits.push_back(best);
+            m_bva_cls.reset();
+            for (auto const& [lit, c] : m_matches)
+                if (lit == best)
+                    m_bva_cls.push_back(c);
+        }
+        return m_bva_lits.size() > 1 && bva_reduction(m_bva_lits.size(), m_bva_cls.size()) > 0;
+    }
+
+    void inprocess::bva_replace(literal l) {
+        // collect the partners before any clause is removed.
+        ptr_vector<clause> partners;
+        for (clause* c : m_bva_cls) {
+            for (literal m : m_bva_lits) {
+                clause* d = find_partner(*c, l, m);
+                VERIFY(d);
+                partners.push_back(d);
+            }
+        }
+        bool_var x = s.mk_var(false, true);
+        m_occs.reserve(2 * s.num_vars());
+        m_marked.reserve(2 * s.num_vars(), false);
+        m_stamp.reserve(2 * s.num_vars(), 0);
+        m_count.reserve(2 * s.num_vars(), 0);
+        for (literal m : m_bva_lits)
+            s.mk_bin_clause(literal(x, true), m, false);
+        for (clause* c : m_bva_cls) {
+            m_lits.reset();
+            m_lits.push_back(literal(x, false));
+            for (literal lit : *c)
+                if (lit != l)
+                    m_lits.push_back(lit);
+            clause* n = s.mk_clause_core(m_lits.size(), m_lits.data(), status::asserted());
+            if (n)
+                add_occ(*n);
+        }
+        for (clause* d : partners)
+            if (!d->was_removed())
+                remove(*d);
+        TRACE("sat", tout << "bva " << x << " " << m_bva_lits << " clauses " << m_bva_cls.size() << "\n";);
+    }
+
+    unsigned inprocess::bva(uint64_t budget) {
+        init_occs();
+        literal_vector lits;
+        for (unsigned i = 0; i < m_occs.size(); ++i)
+            if (m_occs[i].size() >= 3)
+                lits.push_back(to_literal(i));
+        std::stable_sort(lits.begin(), lits.end(), [&](literal a, literal b) { return m_occs[a.index()].size() > m_occs[b.index()].size(); });
+        uint64_t ticks = 0;
+        unsigned num_added = 0;
+        for (literal l : lits) {
+            if (ticks > budget || s.inconsistent())
+                break;
+            s.checkpoint();
+            if (s.value(l) != l_undef || s.was_eliminated(l.var()))
+                continue;
+            if (bva(l, ticks)) {
+                bva_replace(l);
+                ++num_added;
+            }
+        }
+        m_ticks += ticks;
+        // reclaim replaced clauses
+        auto it = s.m_clauses.begin(), it2 = it, end = s.m_clauses.end();
+        for (; it != end; ++it) {
+            if ((*it)->was_removed())
+                s.del_clause(**it);
+            else
+                *it2++ = *it;
+        }
+        s.m_clauses.set_end(it2);
+        m_occs.reset();
+        return num_added;
+    }
+
+    // ------------------------------------
+    // bounded variable elimination
+    //
+    // The simplifier charges each resolution by the size of the resolved clauses,
+    // so the resolution limit bounds elimination effort weighted by clause sizes.
+
+    unsigned inprocess::bve(uint64_t budget, uint64_t& ticks) {
+        unsigned old_limit = s.m_simplifier.get_res_limit();
+        unsigned limit = static_cast<unsigned>(std::min(budget, static_cast<uint64_t>(INT_MAX)));
+        unsigned elim0 = s.m_simplifier.num_elim_vars();
+        s.m_simplifier.set_res_limit(limit);
+        try {
+            s.m_simplifier(false);
+        }
+        catch (...) {
+            s.m_simplifier.set_res_limit(old_limit);
+            throw;
+        }
+        s.m_simplifier.set_res_limit(old_limit);
+        int remaining = s.m_simplifier.elim_counter();
+        ticks = limit - std::min(limit, static_cast<unsigned>(std::max(remaining, 0)));
+        m_ticks += ticks;
+        return s.m_simplifier.num_elim_vars() - elim0;
+    }
+
+    void inprocess::collect_statistics(statistics& st) const {
+        st.update("sat inprocess rounds", m_rounds);
+        st.update("sat inprocess vivify rounds", m_vivify.m_rounds);
+        st.update("sat inprocess vivify skipped", m_vivify.m_skipped);
+        st.update("sat inprocess vivify ticks", static_cast<double>(m_vivify.m_ticks));
+        st.update("sat inprocess vivified literals", m_vivify.m_yield);
+        st.update("sat inprocess bva rounds", m_bva.m_rounds);
+        st.update("sat inprocess bva skipped", m_bva.m_skipped);
+        st.update("sat inprocess bva ticks", static_cast<double>(m_bva.m_ticks));
+        st.update("sat inprocess bva vars", m_bva.m_yield);
+        st.update("sat inprocess bve rounds", m_bve.m_rounds);
+        st.update("sat inprocess bve skipped", m_bve.m_skipped);
+        st.update("sat inprocess bve ticks", static_cast<double>(m_bve.m_ticks));
+        st.update("sat inprocess bve vars", m_bve.m_yield);
+    }
+
+    void inprocess::reset_statistics() {
+        m_rounds = 0;
+        m_vivify.reset_statistics();
+        m_bva.reset_statistics();
+        m_bve.reset_statistics();
+    }
+}
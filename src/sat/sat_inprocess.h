@@ -0,0 +1,103 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_inprocess.h
+
+Abstract:
+
+    Tick based scheduler for inprocessing.
+
+    Search effort is measured in ticks, the number of watch list
+    entries visited during propagation. Each inprocessing round
+    gives vivification of learned clauses, bounded variable addition
+    and bounded variable elimination a budget that is a fraction of
+    the ticks spent in search since the previous round.
+    A technique that does not yield anything is delayed for an
+    exponentially growing number of rounds.
+
+Author:
+
+    agent 2026-10-17
+
+--*/
+#pragma once
+
+#include "sat/sat_types.h"
+#include "util/params.h"
+#include "util/statistics.h"
+
+namespace sat {
+    class solver;
+
+    class inprocess {
+
+        struct technique {
+            unsigned    m_effort = 0;    // budget in per mille of search ticks
+            unsigned    m_delay = 0;     // number of rounds to skip
+            unsigned    m_backoff = 0;
+            // stats
+            unsigned    m_rounds = 0;
+            unsigned    m_skipped = 0;
+            unsigned    m_yield = 0;
+            uint64_t    m_ticks = 0;
+            bool should_run();
+            void update(unsigned yield);
+            void reset_statistics() { m_rounds = m_skipped = m_yield = 0; m_ticks = 0; }
+        };
+
+        solver&    s;
+        uint64_t   m_ticks = 0;
+        uint64_t   m_last_ticks = 0;
+        unsigned   m_rounds = 0;
+        technique  m_vivify, m_bva, m_bve;
+
+        // config
+        bool       m_enabled;
+        unsigned   m_vivify_glue;
+        unsigned   m_min_budget = 10000;    // ticks granted to a technique even after a short search phase
+
+        // vivification
+        literal_vector m_lits;
+        bool vivify(clause& c);
+        unsigned vivify(uint64_t budget);
+
+        // bounded variable addition
+        vector<clause_vector> m_occs;
+        bool_vector           m_marked;
+        svector<unsigned>     m_stamp;
+        svector<unsigned>     m_count;
+        literal_vector        m_bva_lits;
+        clause_vector         m_bva_cls;
+        svector<std::pair<literal, clause*>> m_matches;
+        bool bva_enabled() const;
+        void init_occs();
+        void add_occ(clause& c);
+        literal min_occ(clause const& c, literal l) const;
+        clause* find_partner(clause& c, literal l, literal m);
+        void remove(clause& c);
+        bool bva(literal l, uint64_t& ticks);
+        void bva_replace(literal l);
+        unsigned bva(uint64_t budget);
+
+        unsigned bve(uint64_t budget, uint64_t& ticks);
+
+        uint64_t budget(technique const& t, uint64_t search_ticks) const;
+
+    public:
+        inprocess(solver& s, params_ref const& p);
+
+        bool enabled() const { return m_enabled; }
+
+        void operator()();
+
+        void updt_params(params_ref const& p);
+
+        void collect_statistics(statistics& st) const;
+        void reset_statistics();
+
+        void tick(unsigned n) { m_ticks += n; }
+    };
+
+};
@@ -22,69 +22,66 @@ Revision History:
 
 namespace sat {
 
-    void parallel::vector_pool::next(unsigned& index) {
-        SASSERT(index < m_size);
-        unsigned n = index + 2 + get_length(index);
-        index = (n >= m_size) ? 0 : n;
+    clause_ring::clause_ring(unsigned capacity, unsigned max_size):
+        m_capacity(capacity),
+        m_max_size(max_size),
+        m_seq(new std::atomic<uint64_t>[capacity]),
+        m_sizes(new std::atomic<unsigned>[capacity]),
+        m_lits(new std::atomic<unsigned>[static_cast<size_t>(capacity) * max_size]) {
+        for (unsigned i = 0; i < capacity; ++i) 
+            m_seq[i].store(0, std::memory_order_relaxed);
+        m_long.resize(capacity);
     }
 
-    void parallel::vector_pool::reserve(unsigned num_threads, unsigned sz) {
-        m_vectors.reset();
-        m_vectors.resize(sz, 0);
-        m_heads.reset();
-        m_heads.resize(num_threads, 0);
-        m_at_end.reset();
-        m_at_end.resize(num_threads, true);
-        m_tail = 0;
-        m_size = sz;
-    }
-    
-    void parallel::vector_pool::begin_add_vector(unsigned owner, unsigned n) {
-        SASSERT(m_tail < m_size);
-        unsigned capacity = n + 2;
-        m_vectors.reserve(m_size + capacity, 0);
-        IF_VERBOSE(3, verbose_stream() << owner << ": begin-add " << n << " tail: " << m_tail << " size: " << m_size << "\n";);
-        for (unsigned i = 0; i < m_heads.size(); ++i) {
-            while (m_tail < m_heads[i] && m_heads[i] < m_tail + capacity) {
-                next(m_heads[i]);
-            }
-            m_at_end[i] = false;
+    // only called by the producer owning the ring.
+    void clause_ring::push(unsigned n, literal const* lits) {
+        uint64_t pos = m_tail.load(std::memory_order_relaxed);
+        unsigned idx = static_cast<unsigned>(pos % m_capacity);
+        std::atomic<unsigned>* dst = m_lits.get() + static_cast<size_t>(idx) * m_max_size;
+        m_seq[idx].store(2 * pos + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_sizes[idx].store(n, std::memory_order_relaxed);
+        if (n > m_max_size) {
+            lock_guard lock(m_long_mux);
+            m_long[idx].reset();
+            m_long[idx].append(n, lits);
         }
-        m_vectors[m_tail++] = owner;
-        m_vectors[m_tail++] = n;    
-    }
-
-    void parallel::vector_pool::add_vector_elem(unsigned e) {
-        m_vectors[m_tail++] = e;
-    }
-
-    void parallel::vector_pool::end_add_vector() {
-        if (m_tail >= m_size) 
-            m_tail = 0;
+        else {
+            for (unsigned i = 0; i < n; ++i)
+                dst[i].store(lits[i].index(), std::memory_order_relaxed);
+        }
+        m_seq[idx].store(2 * pos + 2, std::memory_order_release);
+        m_tail.store(pos + 1, std::memory_order_release);
     }
 
-
-    bool parallel::vector_pool::get_vector(unsigned owner, unsigned& n, unsigned const*& ptr) {
-        unsigned head = m_heads[owner];      
-        unsigned iterations = 0;
-        while (head != m_tail || !m_at_end[owner]) {
-            ++iterations;
-            SASSERT(head < m_size && m_tail < m_size);            
-            bool is_self = owner == get_owner(head);
-            next(m_heads[owner]);
-            IF_VERBOSE(static_cast<unsigned>(iterations > m_size ? 0 : 3), verbose_stream() << owner << ": [" << head << ":" << m_heads[owner] << "] tail: " << m_tail << "\n";);
-            m_at_end[owner] = (m_heads[owner] == m_tail);
-            if (!is_self) {
-                n = get_length(head);
-                ptr = get_ptr(head);
-                return true;
-            }
-            head = m_heads[owner];
+    // retrieve the clause at position pos. 
+    // Fails if the slot was overwritten before or while it was copied.
+    bool clause_ring::get(uint64_t pos, literal_vector& lits) const {
+        unsigned idx = static_cast<unsigned>(pos % m_capacity);
+        uint64_t seq = m_seq[idx].load(std::memory_order_acquire);
+        if (seq != 2 * pos + 2)
+            return false;
+        unsigned n = m_sizes[idx].load(std::memory_order_relaxed);
+        std::atomic<unsigned> const* src = m_lits.get() + static_cast<size_t>(idx) * m_max_size;
+        lits.reset();
+        if (n > m_max_size) {
+            lock_guard lock(m_long_mux);
+            lits.append(m_long[idx]);
         }
-        return false;
+        else {
+            for (unsigned i = 0; i < n; ++i)
+                lits.push_back(to_literal(src[i].load(std::memory_order_relaxed)));
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return seq == m_seq[idx].load(std::memory_order_relaxed);
     }
 
-    parallel::parallel(solver& s): m_num_clauses(0), m_consumer_ready(false), m_scoped_rlimit(s.rlimit()) {}
+    parallel::parallel(solver& s): 
+        m_max_glue(s.get_config().m_par_max_glue), 
+        m_max_size(std::max(2u, s.get_config().m_par_max_size)), 
+        m_num_clauses(0), 
+        m_consumer_ready(false), 
+        m_scoped_rlimit(s.rlimit()) {}
 
     parallel::~parallel() {
         reset();
@@ -142,62 +139,109 @@ namespace sat {
         }
     }
 
+    void parallel::reserve(unsigned num_owners, unsigned sz) {
+        m_rings.reset();
+        m_consumers.reset();
+        for (unsigned i = 0; i < num_owners; ++i) {
+            m_rings.push_back(alloc(clause_ring, sz, m_max_size));
+            m_consumers.push_back(alloc(consumer));
+            m_consumers.back()->m_heads.resize(num_owners, 0);
+        }
+    }
+
+    unsigned parallel::clause_hash(unsigned n, literal const* lits) {
+        // independent of the order of literals in the clause.
+        unsigned h = 0;
+        for (unsigned i = 0; i < n; ++i)
+            h += hash_u(lits[i].index());
+        return hash_u(h + n);
+    }
+
+    // clauses that were exported or imported by owner are not shared again.
+    bool parallel::is_duplicate(unsigned owner, unsigned n, literal const* lits) {
+        index_set& seen = m_consumers[owner]->m_seen;
+        if (seen.size() > (1u << 18))
+            seen.reset();
+        unsigned h = clause_hash(n, lits);
+        if (seen.contains(h))
+            return true;
+        seen.insert(h);
+        return false;
+    }
+
+    void parallel::_share_clause(solver& s, unsigned n, literal const* lits) {
+        unsigned owner = s.m_par_id;
+        if (owner >= m_rings.size() || is_duplicate(owner, n, lits))
+            return;
+        IF_VERBOSE(3, verbose_stream() << owner << ": share " << literal_vector(n, lits) << "\n";);
+        m_rings[owner]->push(n, lits);
+        s.m_stats.m_par_exported++;
+    }
+
     void parallel::share_clause(solver& s, literal l1, literal l2) {        
         if (s.get_config().m_num_threads == 1 || s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
-        IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": share " <<  l1 << " " << l2 << "\n";);
-        {
-            lock_guard lock(m_mux);
-            m_pool.begin_add_vector(s.m_par_id, 2);
-            m_pool.add_vector_elem(l1.index());
-            m_pool.add_vector_elem(l2.index());            
-            m_pool.end_add_vector();
-        }        
+        literal lits[2] = { l1, l2 };
+        _share_clause(s, 2, lits);
     }
 
     void parallel::share_clause(solver& s, clause const& c) {        
         if (s.get_config().m_num_threads == 1 || !enable_add(c) || s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
-        unsigned n = c.size();
-        unsigned owner = s.m_par_id;
-        IF_VERBOSE(3, verbose_stream() << owner << ": share " <<  c << "\n";);
-        lock_guard lock(m_mux);
-        m_pool.begin_add_vector(owner, n);                
-        for (unsigned i = 0; i < n; ++i) 
-            m_pool.add_vector_elem(c[i].index());
-        m_pool.end_add_vector();        
+        _share_clause(s, c.size(), c.begin());
     }
 
     void parallel::get_clauses(solver& s) {
         if (s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
-        lock_guard lock(m_mux);
         _get_clauses(s);        
     }
 
+    bool parallel::has_clauses(solver const& s) const {
+        unsigned owner = s.m_par_id;
+        if (owner >= m_consumers.size())
+            return false;
+        svector<uint64_t> const& heads = m_consumers[owner]->m_heads;
+        for (unsigned i = 0; i < m_rings.size(); ++i) 
+            if (i != owner && heads[i] != m_rings[i]->tail())
+                return true;
+        return false;
+    }
+
     void parallel::_get_clauses(solver& s) {
-        unsigned n;
-        unsigned const* ptr;
         unsigned owner = s.m_par_id;
-        while (m_pool.get_vector(owner, n, ptr)) {
-            m_lits.reset();
-            bool usable_clause = true;
-            for (unsigned i = 0; usable_clause && i < n; ++i) {
-                literal lit(to_literal(ptr[i]));                
-                m_lits.push_back(lit);
-                usable_clause = lit.var() <= s.m_par_num_vars && !s.was_eliminated(lit.var());
-            }
-            IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": retrieve " << m_lits << "\n";);
-            SASSERT(n >= 2);
-            if (usable_clause) {
-                s.mk_clause_core(m_lits.size(), m_lits.data(), sat::status::redundant());
+        if (owner >= m_consumers.size())
+            return;
+        literal_vector lits;
+        svector<uint64_t>& heads = m_consumers[owner]->m_heads;
+        for (unsigned i = 0; i < m_rings.size(); ++i) {
+            if (i == owner)
+                continue;
+            clause_ring const& ring = *m_rings[i];
+            uint64_t tail = ring.tail();
+            uint64_t head = heads[i];
+            // skip clauses that were overwritten by the producer.
+            if (tail - head > ring.capacity())
+                head = tail - ring.capacity();
+            for (; head < tail; ++head) {
+                if (!ring.get(head, lits))
+                    continue;
+                SASSERT(lits.size() >= 2);
+                bool usable_clause = all_of(lits, [&](literal lit) { return lit.var() <= s.m_par_num_vars && !s.was_eliminated(lit.var()); });
+                IF_VERBOSE(3, verbose_stream() << owner << ": retrieve " << lits << "\n";);
+                if (usable_clause && !is_duplicate(owner, lits.size(), lits.data())) {
+                    s.m_stats.m_par_imported++;
+                    s.mk_clause_core(lits.size(), lits.data(), sat::status::redundant());
+                }
             }
-        }        
+            heads[i] = tail;
+        }
     }
 
     bool parallel::enable_add(clause const& c) const {
-        // plingeling, glucose heuristic:
-        return (c.size() <= 40 && c.glue() <= 8) || c.glue() <= 2;
+        // plingeling, glucose heuristic.
+        // Clauses with glue at most 2 are shared regardless of sat.par.max_size.
+        return c.glue() <= 2 || (c.size() <= m_max_size && c.glue() <= m_max_glue);
     }
 
     void parallel::_from_solver(solver& s) {
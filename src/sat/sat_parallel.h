@@ -24,30 +24,52 @@ Revision History:
 #include "util/rlimit.h"
 #include "util/scoped_ptr_vector.h"
 #include "util/mutex.h"
+#include <atomic>
+#include <memory>
 
 namespace sat {
 
+    // 
+    // Ring of learned clauses exported by a single producer.
+    // Consumers read the ring without locking. Each slot carries a sequence
+    // number that is odd while the producer writes the slot. A consumer
+    // discards a slot whose sequence number changed while it was copied.
+    // Slots hold up to max_size literals. Longer clauses are rare, since only
+    // clauses with glue at most 2 are shared regardless of size, and they are
+    // kept outside the slots under a lock.
+    //
+    class clause_ring {
+        unsigned                                m_capacity;
+        unsigned                                m_max_size;
+        std::unique_ptr<std::atomic<uint64_t>[]> m_seq;
+        std::unique_ptr<std::atomic<unsigned>[]> m_sizes;
+        std::unique_ptr<std::atomic<unsigned>[]> m_lits;
+        std::atomic<uint64_t>                   m_tail { 0 };
+        mutable mutex                           m_long_mux;
+        vector<literal_vector>                  m_long;
+    public:
+        clause_ring(unsigned capacity, unsigned max_size);
+        uint64_t tail() const { return m_tail.load(std::memory_order_acquire); }
+        unsigned capacity() const { return m_capacity; }
+        void push(unsigned n, literal const* lits);
+        bool get(uint64_t pos, literal_vector& lits) const;
+    };
+
     class parallel {
 
-        // shared pool of learned clauses.
-        class vector_pool {
-            unsigned_vector m_vectors;
-            unsigned        m_size{ 0 };
-            unsigned        m_tail{ 0 };
-            unsigned_vector m_heads;
-            bool_vector   m_at_end;
-            void next(unsigned& index);
-            unsigned get_owner(unsigned index) const { return m_vectors[index]; }
-            unsigned get_length(unsigned index) const { return m_vectors[index+1]; }
-            unsigned const* get_ptr(unsigned index) const { return m_vectors.data() + index + 2; }
-        public:
-            void reserve(unsigned num_owners, unsigned sz);
-            void begin_add_vector(unsigned owner, unsigned n);
-            void end_add_vector();
-            void add_vector_elem(unsigned e);
-            bool get_vector(unsigned owner, unsigned& n, unsigned const*& ptr);
+        typedef hashtable<unsigned, u_hash, u_eq> index_set;
+
+        // per-solver state for importing clauses.
+        // It is only accessed by the thread that owns the solver.
+        struct consumer {
+            svector<uint64_t> m_heads;
+            index_set         m_seen;
         };
 
+        static unsigned clause_hash(unsigned n, literal const* lits);
+        bool is_duplicate(unsigned owner, unsigned n, literal const* lits);
+        void _share_clause(solver& s, unsigned n, literal const* lits);
+
         bool enable_add(clause const& c) const;
         void _get_clauses(solver& s);
         void _from_solver(solver& s);
@@ -55,12 +77,13 @@ namespace sat {
         bool _from_solver(i_local_search& s);
         void _to_solver(i_local_search& s);
 
-        typedef hashtable<unsigned, u_hash, u_eq> index_set;
         literal_vector m_units;
         index_set      m_unit_set;
-        literal_vector m_lits;
-        vector_pool    m_pool;
         mutex          m_mux;
+        unsigned       m_max_glue;
+        unsigned       m_max_size;
+        scoped_ptr_vector<clause_ring> m_rings;
+        scoped_ptr_vector<consumer>    m_consumers;
 
         // for exchange with local search:
         unsigned           m_num_clauses;
@@ -84,8 +107,8 @@ namespace sat {
 
         void push_child(reslimit& rl);
 
-        // reserve space
-        void reserve(unsigned num_owners, unsigned sz) { m_pool.reserve(num_owners, sz); }
+        // reserve a ring with sz clause slots for each owner
+        void reserve(unsigned num_owners, unsigned sz);
 
         solver& get_solver(unsigned i) { return *m_solvers[i]; }
 
@@ -102,6 +125,9 @@ namespace sat {
         // receive clauses from shared clause pool
         void get_clauses(solver& s);
 
+        // check if other solvers exported clauses that s has not imported.
+        bool has_clauses(solver const& s) const;
+
         // exchange from solver state to local search and back.
         void from_solver(solver& s);
         void to_solver(solver& s);
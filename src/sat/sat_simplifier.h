@@ -234,6 +234,12 @@ namespace sat {
 
         void operator()(bool learned);
 
+        // resolution budget used by variable elimination
+        unsigned get_res_limit() const { return m_res_limit; }
+        void set_res_limit(unsigned l) { m_res_limit = l; }
+        int elim_counter() const { return m_elim_counter; }
+        unsigned num_elim_vars() const { return m_num_elim_vars; }
+
         void updt_params(params_ref const & p);
         static void collect_param_descrs(param_descrs & d);
 
@@ -40,6 +40,18 @@ Revision History:
 
 namespace sat {
 
+    static const int PREFETCH_DISTANCE = 4;
+
+    static inline void prefetch(void const* p) {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(p);
+#else
+    #if !defined(_M_ARM) && !defined(_M_ARM64)
+        _mm_prefetch((const char*)p, _MM_HINT_T1);
+    #endif
+#endif
+    }
+
 
     solver::solver(params_ref const & p, reslimit& l):
         solver_core(l),
@@ -53,6 +65,7 @@ namespace sat {
         m_scc(*this, p),
         m_asymm_branch(*this, p),
         m_probing(*this, p),
+        m_inprocess(*this, p),
         m_mus(*this),
         m_inconsistent(false),
         m_searching(false),
@@ -495,8 +508,8 @@ namespace sat {
         else if (has_variables_to_reinit(l1, l2))
             push_reinit_stack(l1, l2);
         m_stats.m_mk_bin_clause++;
-        get_wlist(~l1).push_back(watched(l2, redundant));
-        get_wlist(~l2).push_back(watched(l1, redundant));
+        add_binary_watch(get_wlist(~l1), watched(l2, redundant));
+        add_binary_watch(get_wlist(~l2), watched(l1, redundant));
     }
 
     bool solver::has_variables_to_reinit(clause const& c) const {
@@ -662,6 +675,17 @@ namespace sat {
     void solver::defrag_clauses() {
         m_defrag_threshold = 2;
         if (memory_pressure()) return;
+
+        // Propagation visits the watch list of each literal that is assigned true.
+        // Order literals as propagation is expected to visit them: first the literals
+        // assigned above the base level, then the phase literal of the remaining
+        // variables by activity, and finally their complements.
+        literal_vector lits;
+        init_visited();
+        for (unsigned i = init_trail_size(); i < m_trail.size(); ++i) {
+            lits.push_back(m_trail[i]);
+            mark_visited(m_trail[i]);
+        }
         pop(scope_lvl());
         IF_VERBOSE(2, verbose_stream() << "(sat-defrag)\n");
         clause_allocator& alloc = m_cls_allocator[!m_cls_allocator_idx];
@@ -672,8 +696,16 @@ namespace sat {
         svector<bool_var> vars;
         for (unsigned i = 0; i < num_vars(); ++i) vars.push_back(i);
         std::stable_sort(vars.begin(), vars.end(), cmp_activity(*this));
-        literal_vector lits;
-        for (bool_var v : vars) lits.push_back(literal(v, false)), lits.push_back(literal(v, true));
+        for (bool_var v : vars) {
+            literal lit(v, !m_phase[v]);
+            if (!is_visited(lit))
+                lits.push_back(lit), mark_visited(lit);
+        }
+        for (bool_var v : vars) {
+            literal lit(v, m_phase[v]);
+            if (!is_visited(lit))
+                lits.push_back(lit), mark_visited(lit);
+        }
         // walk clauses, reallocate them in an order that defragments memory and creates locality.
         for (literal lit : lits) {
             watch_list& wlist = m_watches[lit.index()];
@@ -701,20 +733,16 @@ namespace sat {
             }
         }
 
-        // reallocate ternary clauses.
+        // reallocate clauses that are not watched, such as frozen clauses.
         for (clause* c : m_clauses) {
-            if (!c->was_used()) {
-                SASSERT(c->size() == 3);
+            if (!c->was_used()) 
                 new_clauses.push_back(alloc.copy_clause(*c));
-            }
             dealloc_clause(c);
         }
 
         for (clause* c : m_learned) {
-            if (!c->was_used()) {
-                SASSERT(c->size() == 3);
+            if (!c->was_used()) 
                 new_learned.push_back(alloc.copy_clause(*c));
-            }
             dealloc_clause(c);
         }
         m_clauses.swap(new_clauses);
@@ -919,15 +947,8 @@ namespace sat {
             }
         }
         
-        if (m_config.m_propagate_prefetch) {
-#if defined(__GNUC__) || defined(__clang__)
-            __builtin_prefetch((const char*)((m_watches[l.index()].data())));
-#else
-    #if !defined(_M_ARM) && !defined(_M_ARM64)
-            _mm_prefetch((const char*)((m_watches[l.index()].data())), _MM_HINT_T1);
-    #endif
-#endif
-        }
+        if (m_config.m_propagate_prefetch) 
+            prefetch(m_watches[l.index()].data());
 
         SASSERT(!l.sign() || !m_phase[v]);
         SASSERT(l.sign()  || m_phase[v]);
@@ -1023,6 +1044,7 @@ namespace sat {
         watch_list& wlist = m_watches[l.index()];
         m_asymm_branch.dec(wlist.size());
         m_probing.dec(wlist.size());
+        m_inprocess.tick(wlist.size());
         watch_list::iterator it = wlist.begin();
         watch_list::iterator it2 = it;
         watch_list::iterator end = wlist.end();
@@ -1051,6 +1073,10 @@ namespace sat {
                 it2++;
                 break;
             case watched::CLAUSE: {
+                // binary watches come first, so the remaining entries are mostly clauses.
+                // Fetch the clause a few entries ahead of the cursor.
+                if (m_config.m_propagate_prefetch && end - it > PREFETCH_DISTANCE && it[PREFETCH_DISTANCE].is_clause())
+                    prefetch(&get_clause(it[PREFETCH_DISTANCE].get_clause_offset()));
                 if (value(it->get_blocked_literal()) == l_true) {
                     TRACE("propagate_clause_bug", tout << "blocked literal " << it->get_blocked_literal() << "\n";
                     tout << get_clause(it) << "\n";);
@@ -1498,7 +1524,7 @@ namespace sat {
 #define IS_MAIN_SOLVER(i)  (i == main_solver_offset)
 
         sat::parallel par(*this);
-        par.reserve(num_threads, 1 << 12);
+        par.reserve(num_threads, 1 << 10);
         par.init_solvers(*this, num_extra_solvers);
         for (unsigned i = 0; i < ls.size(); ++i) {
             par.push_child(ls[i]->rlimit());
@@ -1612,11 +1638,29 @@ namespace sat {
     }
 #endif
 
+    /*
+      \brief force a restart to import clauses from parallel solvers
+      when sat.par.import_interval conflicts have passed since the last import.
+     */
+    bool solver::should_import_par() const {
+        return 
+            m_par && 
+            m_config.m_par_import_interval > 0 &&
+            m_conflicts_since_par_import >= m_config.m_par_import_interval &&
+            scope_lvl() > search_lvl() &&
+            m_par->has_clauses(*this);
+    }
+
     /*
       \brief import lemmas/units from parallel sat solvers.
      */
     void solver::exchange_par() {
-        if (m_par && at_base_lvl() && m_config.m_num_threads > 1) m_par->get_clauses(*this);
+        if (m_par && at_base_lvl() && m_config.m_num_threads > 1) 
+            m_par->get_clauses(*this);
+        // clauses are imported at base level only. Under assumptions the 
+        // import is postponed, the forced restart has reached the search level.
+        if (m_par && scope_lvl() == search_lvl())
+            m_conflicts_since_par_import = 0;
         if (m_par && at_base_lvl() && m_config.m_num_threads > 1) {
             // SASSERT(scope_lvl() == search_lvl());
             // TBD: import also dependencies of assumptions.
@@ -1773,7 +1817,7 @@ namespace sat {
             else if (do_cleanup(false)) continue;
             else if (should_gc()) do_gc();
             else if (should_rephase()) do_rephase();
-            else if (should_restart()) { if (!m_restart_enabled) return l_undef; do_restart(!m_config.m_restart_fast); }
+            else if (should_restart()) { if (!m_restart_enabled) return l_undef; do_restart(!m_config.m_restart_fast || should_import_par()); }
             else if (should_simplify()) do_simplify();
             else if (!decide()) is_sat = final_check();
         }
@@ -2051,7 +2095,10 @@ namespace sat {
             m_ext->pre_simplify();
         }
       
-        m_simplifier(false);
+        if (m_inprocess.enabled())
+            m_inprocess();
+        else
+            m_simplifier(false);
 
         CASSERT("sat_simplify_bug", check_invariant());
         CASSERT("sat_missed_prop", check_missed_propagation());
@@ -2264,9 +2311,10 @@ namespace sat {
     }
 
     bool solver::should_restart() const {
-        if (m_conflicts_since_restart <= m_restart_threshold) return false;
         if (scope_lvl() < 2 + search_lvl()) return false;
         if (m_case_split_queue.empty()) return false;
+        if (should_import_par()) return true;
+        if (m_conflicts_since_restart <= m_restart_threshold) return false;
         if (m_config.m_restart != RS_EMA) return true;
         return 
             m_fast_glue_avg + search_lvl() <= scope_lvl() && 
@@ -2435,6 +2483,7 @@ namespace sat {
         m_conflicts_since_init++;
         m_conflicts_since_restart++;
         m_conflicts_since_gc++;
+        m_conflicts_since_par_import++;
         m_stats.m_conflict++;
         if (m_step_size > m_config.m_step_size_min)
             m_step_size -= m_config.m_step_size_dec;        
@@ -3756,6 +3805,7 @@ namespace sat {
         m_simplifier.updt_params(p);
         m_asymm_branch.updt_params(p);
         m_probing.updt_params(p);
+        m_inprocess.updt_params(p);
         m_scc.updt_params(p);
         m_rand.set_seed(m_config.m_random_seed);
         m_step_size = m_config.m_step_size_init;
@@ -3786,6 +3836,7 @@ namespace sat {
         m_scc.collect_statistics(st);
         m_asymm_branch.collect_statistics(st);
         m_probing.collect_statistics(st);
+        m_inprocess.collect_statistics(st);
         if (m_ext) m_ext->collect_statistics(st);
         if (m_local_search) m_local_search->collect_statistics(st);
         if (m_cut_simplifier) m_cut_simplifier->collect_statistics(st);
@@ -3798,6 +3849,7 @@ namespace sat {
         m_simplifier.reset_statistics();
         m_asymm_branch.reset_statistics();
         m_probing.reset_statistics();
+        m_inprocess.reset_statistics();
         m_aux_stats.reset();
     }
 
@@ -4769,6 +4821,8 @@ namespace sat {
         st.update("sat elim bool vars bdd", m_elim_var_bdd);
         st.update("sat backjumps", m_backjumps);
         st.update("sat backtracks", m_backtracks);
+        st.update("sat par imported", m_par_imported);
+        st.update("sat par exported", m_par_exported);
     }
 
     void stats::reset() {
@@ -41,6 +41,7 @@ Revision History:
 #include "sat/sat_asymm_branch.h"
 #include "sat/sat_cut_simplifier.h"
 #include "sat/sat_probing.h"
+#include "sat/sat_inprocess.h"
 #include "sat/sat_mus.h"
 #include "sat/sat_drat.h"
 #include "sat/sat_parallel.h"
@@ -78,6 +79,8 @@ namespace sat {
         unsigned m_units;
         unsigned m_backtracks;
         unsigned m_backjumps;
+        unsigned m_par_imported;
+        unsigned m_par_exported;
         stats() { reset(); }
         void reset();
         void collect_statistics(statistics & st) const;
@@ -111,6 +114,7 @@ namespace sat {
         scc                     m_scc;
         asymm_branch            m_asymm_branch;
         probing                 m_probing;
+        inprocess               m_inprocess;
         bool                    m_is_probing { false };
         mus                     m_mus;           // MUS for minimal core extraction
         bool                    m_inconsistent;
@@ -218,6 +222,7 @@ namespace sat {
         friend class bcd;
         friend class mus;
         friend class probing;
+        friend class inprocess;
         friend class simplifier;
         friend class scc;
         friend class pb::solver;
@@ -238,6 +243,7 @@ namespace sat {
         friend class npn3_finder;
         friend class proof_trim;
         friend struct backoff;
+        friend class gc_test;
     public:
         solver(params_ref const & p, reslimit& l);
         ~solver() override;
@@ -543,7 +549,9 @@ namespace sat {
         unsigned m_restart_threshold = 0;
         unsigned m_luby_idx = 0;
         unsigned m_conflicts_since_gc = 0;
+        unsigned m_conflicts_since_par_import = 0;
         unsigned m_gc_threshold = 0;
+        clause_vector m_gc_local;
         unsigned m_defrag_threshold = 0;
         unsigned m_num_checkpoints = 0;
         double   m_min_d_tk = 0.0 ;
@@ -590,6 +598,7 @@ namespace sat {
         bool reached_max_conflicts();
         void sort_watch_lits();
         void exchange_par();
+        bool should_import_par() const;
         lbool check_par(unsigned num_lits, literal const* lits);
         lbool do_local_search(unsigned num_lits, literal const* lits);
         lbool do_ddfw_search(unsigned num_lits, literal const* lits);
@@ -614,6 +623,7 @@ namespace sat {
         void save_psm();
         void gc_half(char const * st_name);
         void gc_dyn_psm();
+        void gc_tiered();
         bool activate_frozen_clause(clause & c);
         unsigned psm(clause const & c) const;
         bool can_delete(clause const & c) const;
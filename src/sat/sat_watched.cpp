@@ -19,6 +19,7 @@ Revision History:
 #include "sat/sat_watched.h"
 #include "sat/sat_clause.h"
 #include "sat/sat_extension.h"
+#include <algorithm>
 
 namespace sat {
 
@@ -40,6 +41,19 @@ namespace sat {
         return false;                                           
     }
 
+    void add_binary_watch(watch_list & wlist, watched const& w) {
+        SASSERT(w.is_binary_clause());
+        wlist.push_back(w);
+        unsigned sz = wlist.size();
+        if (sz == 1 || wlist[sz - 2].is_binary_clause())
+            return;
+        // binary watches form a prefix of the watch list, so the boundary is found by bisection.
+        // If the order was not maintained, the new watch stays at the end.
+        auto it = std::partition_point(wlist.begin(), wlist.end() - 1, [](watched const& w) { return w.is_binary_clause(); });
+        if (!it->is_binary_clause())
+            std::swap(*it, wlist.back());
+    }
+
     watched* find_binary_watch(watch_list & wlist, literal l) {
         for (watched& w : wlist) {
             if (w.is_binary_clause() && w.get_literal() == l) return &w;
@@ -546,6 +546,9 @@ namespace q {
         }
 
         void add_candidate(euf::solver& ctx, enode * n) {
+            // consecutive merges often report the same parent again
+            if (m_qhead < m_candidates.size() && m_candidates.back() == n)
+                return;
             m_candidates.push_back(n);
             ctx.push(push_back_trail<enode*, false>(m_candidates));
         }
@@ -3847,7 +3850,7 @@ namespace q {
         }
 
         bool can_propagate() const override {
-            return !m_to_match.empty() || !m_new_patterns.empty();
+            return m_to_match_head < m_to_match.size() || !m_new_patterns.empty();
         }
 
         void on_merge(enode * root, enode * other) override {            
@@ -527,6 +527,9 @@ namespace {
         }
 
         void add_candidate(enode * n) {
+            // consecutive merges often report the same parent again
+            if (!m_candidates.empty() && m_candidates.back() == n)
+                return;
             m_candidates.push_back(n);
         }
 
@@ -3887,12 +3890,33 @@ namespace {
 
         void match() override {
             TRACE("trigger_bug", tout << "match\n"; display(tout););
-            for (code_tree* t : m_to_match) {
+            qi_profiler* p = m_context.get_qi_profiler();
+            unsigned i = 0, sz = m_to_match.size();
+            for (; i < sz; ++i) {
+                code_tree* t = m_to_match[i];
                 SASSERT(t->has_candidates());
-                if (!m_interpreter.execute(t))
-                    return;
+                bool ok;
+                if (p) {
+                    stopwatch sw;
+                    sw.start();
+                    ok = m_interpreter.execute(t);
+                    p->on_match_time(t->get_root_lbl(), sw.get_current_seconds());
+                }
+                else
+                    ok = m_interpreter.execute(t);
+                if (!ok)
+                    break;
                 t->reset_candidates();
             }
+            if (i < sz) {
+                // resume with the interrupted tree in the next round,
+                // trees that were completed have no candidates left.
+                unsigned j = 0;
+                for (; i < sz; ++i, ++j)
+                    m_to_match[j] = m_to_match[i];
+                m_to_match.shrink(j);
+                return;
+            }
             m_to_match.reset();
             if (!m_new_patterns.empty()) {
                 match_new_patterns();
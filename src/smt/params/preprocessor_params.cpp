@@ -31,6 +31,7 @@ void preprocessor_params::updt_local_params(params_ref const & _p) {
     m_solve_eqs               = p.solve_eqs();
     m_ng_lift_ite             = static_cast<lift_ite_kind>(p.q_lift_ite());
     m_bound_simplifier        = p.bound_simplifier();
+    m_preprocess_threads      = p.preprocess_threads();
 }
 
 void preprocessor_params::updt_params(params_ref const & p) {
@@ -65,4 +66,5 @@ void preprocessor_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_pre_simplifier);
     DISPLAY_PARAM(m_nlquant_elim);
     DISPLAY_PARAM(m_bound_simplifier);
+    DISPLAY_PARAM(m_preprocess_threads);
 }
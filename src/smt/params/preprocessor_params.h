@@ -50,6 +50,7 @@ struct preprocessor_params : public pattern_inference_params,
     bool            m_pre_simplifier = true;
     bool            m_nlquant_elim = false;
     bool            m_bound_simplifier = true;
+    unsigned        m_preprocess_threads = 1;
 
 public:
     preprocessor_params(params_ref const & p = params_ref()):
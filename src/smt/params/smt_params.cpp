@@ -41,6 +41,7 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_theory_aware_branching = p.theory_aware_branching();
     m_delay_units = p.delay_units();
     m_delay_units_threshold = p.delay_units_threshold();
+    m_chrono_backtrack = p.chrono_backtrack();
     m_preprocess = _p.get_bool("preprocess", true); // hidden parameter
     m_max_conflicts = p.max_conflicts();
     m_restart_max   = p.restart_max();
@@ -48,6 +49,7 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_threads       = p.threads();
     m_threads_max_conflicts  = p.threads_max_conflicts();
     m_threads_cube_frequency = p.threads_cube_frequency();
+    m_threads_cube_and_conquer = p.threads_cube_and_conquer();
     m_core_validate = p.core_validate();
     m_sls_enable = p.sls_enable();
     m_sls_parallel = p.sls_parallel();
@@ -124,6 +126,7 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_threads);
     DISPLAY_PARAM(m_threads_max_conflicts);
     DISPLAY_PARAM(m_threads_cube_frequency);
+    DISPLAY_PARAM(m_threads_cube_and_conquer);
     DISPLAY_PARAM(m_simplify_clauses);
     DISPLAY_PARAM(m_tick);
     DISPLAY_PARAM(m_display_features);
@@ -139,6 +142,7 @@ void smt_params::display(std::ostream & out) const {
 
     DISPLAY_PARAM(m_delay_units);
     DISPLAY_PARAM(m_delay_units_threshold);
+    DISPLAY_PARAM(m_chrono_backtrack);
 
     DISPLAY_PARAM(m_theory_resolve);
 
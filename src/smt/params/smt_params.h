@@ -106,6 +106,7 @@ struct smt_params : public preprocessor_params,
     unsigned         m_threads = 1;
     unsigned         m_threads_max_conflicts = UINT_MAX;
     unsigned         m_threads_cube_frequency = 2;
+    bool             m_threads_cube_and_conquer = false;
     bool             m_simplify_clauses = true;
     unsigned         m_tick = 1000;
     bool             m_display_features = false;
@@ -136,6 +137,13 @@ struct smt_params : public preprocessor_params,
     bool             m_delay_units = false;
     unsigned         m_delay_units_threshold = 32;
 
+    // -----------------------------------
+    //
+    // Chronological backtracking
+    //
+    // -----------------------------------
+    unsigned         m_chrono_backtrack = 0;
+
     // -----------------------------------
     //
     // Conflict resolution
@@ -38,6 +38,7 @@ void theory_arith_params::updt_params(params_ref const & _p) {
     m_arith_auto_config_simplex = p.arith_auto_config_simplex();
     m_arith_validate = p.arith_validate();
     m_arith_dump_lemmas = p.arith_dump_lemmas();
+    m_arith_cache_lemmas = p.arith_cache_lemmas();
     m_nl_arith_propagate_linear_monomials = p.arith_nl_propagate_linear_monomials();
     m_nl_arith_optimize_bounds = p.arith_nl_optimize_bounds();
     m_nl_arith_cross_nested = p.arith_nl_cross_nested();
@@ -99,4 +100,5 @@ void theory_arith_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_nl_arith_cross_nested);
     DISPLAY_PARAM(m_arith_validate);
     DISPLAY_PARAM(m_arith_dump_lemmas);
+    DISPLAY_PARAM(m_arith_cache_lemmas);
 }
@@ -84,6 +84,7 @@ struct theory_arith_params {
 
     bool                    m_arith_validate = false;
     bool                    m_arith_dump_lemmas = false;
+    bool                    m_arith_cache_lemmas = false;
     arith_pivot_strategy    m_arith_pivot_strategy = arith_pivot_strategy::ARITH_PIVOT_SMALLEST;
 
     // used in diff-logic
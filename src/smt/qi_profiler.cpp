@@ -0,0 +1,190 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    qi_profiler.cpp
+
+Abstract:
+
+    Quantifier instantiation profiler.
+
+Author:
+
+    agent 2026-10-17
+
+--*/
+
+#include "ast/ast_pp.h"
+#include "smt/qi_profiler.h"
+#include "smt/smt_enode.h"
+#include <fstream>
+#include <sstream>
+
+namespace smt {
+
+    qi_profiler::qi_profiler(ast_manager& m):
+        m(m),
+        m_quantifiers(m),
+        m_patterns(m),
+        m_lbls(m) {
+    }
+
+    unsigned qi_profiler::qidx(quantifier* q) {
+        unsigned idx;
+        if (m_q2idx.find(q, idx))
+            return idx;
+        idx = m_quantifiers.size();
+        m_quantifiers.push_back(q);
+        m_q2idx.insert(q, idx);
+        m_qstats.push_back(qstat());
+        return idx;
+    }
+
+    unsigned qi_profiler::creator(enode* n) const {
+        unsigned id = n->get_owner_id();
+        return id < m_expr2q.size() ? m_expr2q[id] : 0;
+    }
+
+    qi_profiler::scoped_instance::scoped_instance(qi_profiler* p, quantifier* q): p(p), m_old(0) {
+        if (p) {
+            m_old = p->m_current;
+            p->m_current = 1 + p->qidx(q);
+            p->m_qstats[p->m_current - 1].m_instances++;
+        }
+    }
+
+    qi_profiler::scoped_instance::~scoped_instance() {
+        if (p)
+            p->m_current = m_old;
+    }
+
+    void qi_profiler::on_match(quantifier* q, app* pat, unsigned num_bindings, enode* const* bindings) {
+        unsigned idx = qidx(q);
+        m_qstats[idx].m_matches++;
+        if (pat) {
+            uint64_t key = (static_cast<uint64_t>(idx) << 32) | pat->get_id();
+            unsigned pidx;
+            if (!m_pattern2idx.find(key, pidx)) {
+                pidx = m_patterns.size();
+                m_patterns.push_back(pat);
+                m_pattern2idx.insert(key, pidx);
+                m_pstats.push_back(pstat(idx));
+            }
+            m_pstats[pidx].m_matches++;
+        }
+        // each quantifier whose instance created one of the bindings
+        // contributes one edge to the matching-loop graph.
+        m_creators.reset();
+        for (unsigned i = 0; i < num_bindings; ++i) {
+            unsigned c = creator(bindings[i]);
+            if (c != 0 && !m_creators.contains(c))
+                m_creators.push_back(c);
+        }
+        for (unsigned c : m_creators) {
+            uint64_t key = (static_cast<uint64_t>(c - 1) << 32) | idx;
+            m_edges.insert_if_not_there(key, 0)++;
+        }
+    }
+
+    void qi_profiler::on_mk_enode(enode* n) {
+        m_expr2q.setx(n->get_owner_id(), m_current, 0);
+    }
+
+    void qi_profiler::on_mk_bool_var(bool_var v) {
+        m_var2q.setx(v, m_current, 0);
+    }
+
+    void qi_profiler::on_resolve(bool_var v, unsigned conflict_id) {
+        if (v >= static_cast<bool_var>(m_var2q.size()) || m_var2q[v] == 0)
+            return;
+        qstat& st = m_qstats[m_var2q[v] - 1];
+        if (st.m_last_conflict != conflict_id) {
+            st.m_last_conflict = conflict_id;
+            st.m_conflicts++;
+        }
+    }
+
+    void qi_profiler::on_match_time(func_decl* lbl, double seconds) {
+        unsigned idx;
+        if (!m_lbl2idx.find(lbl, idx)) {
+            idx = m_lbls.size();
+            m_lbls.push_back(lbl);
+            m_lbl2idx.insert(lbl, idx);
+            m_match_time.push_back(0);
+        }
+        m_match_time[idx] += seconds;
+    }
+
+    static std::ostream& json_string(std::ostream& out, std::string const& s) {
+        out << '"';
+        for (char c : s) {
+            switch (c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            case '\r': out << "\\r"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                    out << "\\u00" << "0123456789abcdef"[(c >> 4) & 0xf] << "0123456789abcdef"[c & 0xf];
+                else
+                    out << c;
+            }
+        }
+        return out << '"';
+    }
+
+    static std::ostream& json_string(std::ostream& out, symbol const& s) {
+        return json_string(out, s.str());
+    }
+
+    std::ostream& qi_profiler::display_json(std::ostream& out) const {
+        out << "{\n  \"quantifiers\": [";
+        for (unsigned i = 0; i < m_quantifiers.size(); ++i) {
+            qstat const& st = m_qstats[i];
+            out << (i == 0 ? "\n" : ",\n") << "    {\"qid\": ";
+            json_string(out, m_quantifiers.get(i)->get_qid());
+            out << ", \"id\": " << m_quantifiers.get(i)->get_id()
+                << ", \"matches\": " << st.m_matches
+                << ", \"instances\": " << st.m_instances
+                << ", \"conflicts\": " << st.m_conflicts << "}";
+        }
+        out << "\n  ],\n  \"patterns\": [";
+        for (unsigned i = 0; i < m_patterns.size(); ++i) {
+            std::ostringstream strm;
+            strm << mk_ismt2_pp(m_patterns.get(i), m);
+            out << (i == 0 ? "\n" : ",\n") << "    {\"qid\": ";
+            json_string(out, m_quantifiers.get(m_pstats[i].m_qidx)->get_qid());
+            out << ", \"pattern\": ";
+            json_string(out, strm.str());
+            out << ", \"matches\": " << m_pstats[i].m_matches << "}";
+        }
+        out << "\n  ],\n  \"ematching\": [";
+        for (unsigned i = 0; i < m_lbls.size(); ++i) {
+            out << (i == 0 ? "\n" : ",\n") << "    {\"symbol\": ";
+            json_string(out, m_lbls.get(i)->get_name());
+            out << ", \"seconds\": " << m_match_time[i] << "}";
+        }
+        out << "\n  ],\n  \"instantiation_graph\": [";
+        bool first = true;
+        for (auto const& kv : m_edges) {
+            out << (first ? "\n" : ",\n") << "    {\"from\": ";
+            json_string(out, m_quantifiers.get(static_cast<unsigned>(kv.m_key >> 32))->get_qid());
+            out << ", \"to\": ";
+            json_string(out, m_quantifiers.get(static_cast<unsigned>(kv.m_key & 0xffffffff))->get_qid());
+            out << ", \"count\": " << kv.m_value << "}";
+            first = false;
+        }
+        return out << "\n  ]\n}\n";
+    }
+
+    void qi_profiler::write(std::string const& file_name) const {
+        std::ofstream out(file_name);
+        if (out.bad() || out.fail()) {
+            warning_msg("could not open file '%s' for the quantifier profile", file_name.c_str());
+            return;
+        }
+        display_json(out);
+    }
+}
@@ -0,0 +1,95 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    qi_profiler.h
+
+Abstract:
+
+    Quantifier instantiation profiler.
+
+    Attributes E-matching work, instances and conflicts to quantifiers
+    and patterns. Terms and atoms created while an instance is
+    internalized are tagged with the instantiated quantifier, so that
+    matches on these terms give rise to edges of a matching-loop graph,
+    and conflicts that resolve on these atoms are charged to the
+    quantifier.
+
+    The report is written as JSON to the file given by qi.profile_file
+    at the end of each check-sat.
+
+Author:
+
+    agent 2026-10-17
+
+--*/
+#pragma once
+
+#include "ast/ast.h"
+#include "util/map.h"
+#include "util/obj_hashtable.h"
+#include "smt/smt_types.h"
+
+namespace smt {
+
+    class qi_profiler {
+
+        struct qstat {
+            unsigned m_matches = 0;
+            unsigned m_instances = 0;
+            unsigned m_conflicts = 0;
+            unsigned m_last_conflict = UINT_MAX;
+        };
+
+        struct pstat {
+            unsigned m_qidx;
+            unsigned m_matches = 0;
+            pstat(unsigned qidx): m_qidx(qidx) {}
+        };
+
+        ast_manager&               m;
+        quantifier_ref_vector      m_quantifiers;
+        obj_map<quantifier, unsigned> m_q2idx;
+        svector<qstat>             m_qstats;
+        app_ref_vector             m_patterns;
+        u64_map<unsigned>          m_pattern2idx;
+        svector<pstat>             m_pstats;
+        func_decl_ref_vector       m_lbls;
+        obj_map<func_decl, unsigned> m_lbl2idx;
+        svector<double>            m_match_time;
+        u64_map<unsigned>          m_edges;     // (creator, triggered) -> count
+        unsigned_vector            m_expr2q;    // expr id -> 1 + index of creating quantifier
+        unsigned_vector            m_var2q;     // bool var -> 1 + index of creating quantifier
+        unsigned                   m_current = 0;
+        unsigned_vector            m_creators;
+
+        unsigned qidx(quantifier* q);
+        unsigned creator(enode* n) const;
+
+    public:
+        qi_profiler(ast_manager& m);
+
+        /**
+           \brief tag terms and atoms created during the lifetime of the
+           object with q.
+        */
+        class scoped_instance {
+            qi_profiler* p;
+            unsigned     m_old;
+        public:
+            scoped_instance(qi_profiler* p, quantifier* q);
+            ~scoped_instance();
+        };
+
+        void on_match(quantifier* q, app* pat, unsigned num_bindings, enode* const* bindings);
+        void on_mk_enode(enode* n);
+        void on_mk_bool_var(bool_var v);
+        void on_resolve(bool_var v, unsigned conflict_id);
+        void on_match_time(func_decl* lbl, double seconds);
+
+        std::ostream& display_json(std::ostream& out) const;
+        void write(std::string const& file_name) const;
+    };
+
+}
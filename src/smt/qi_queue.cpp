@@ -325,6 +325,7 @@ namespace smt {
         m_stats.m_num_instances++;
         unsigned gen = get_new_gen(q, generation, ent.m_cost);
         display_instance_profile(f, q, num_bindings, bindings, proof_id, gen);
+        qi_profiler::scoped_instance _profile(m_context.get_qi_profiler(), q);
         m_context.internalize_instance(lemma, pr1, gen);
         if (f->get_def()) {
             m_context.internalize(f->get_def(), true);
@@ -320,6 +320,8 @@ namespace smt {
         if (!m_ctx.is_marked(var) && lvl > m_ctx.get_base_level()) {
             m_ctx.set_mark(var);
             m_ctx.inc_bvar_activity(var);
+            if (qi_profiler* p = m_ctx.get_qi_profiler())
+                p->on_resolve(var, m_ctx.get_num_conflicts());
             expr * n = m_ctx.bool_var2expr(var);
             if (is_app(n)) {
                 family_id fid = to_app(n)->get_family_id();
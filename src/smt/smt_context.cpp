@@ -97,6 +97,9 @@ namespace smt {
             m_fparams.m_relevancy_lemma = false;
 
         m_model_generator->set_context(this);
+
+        if (!m_fparams.m_qi_profile_file.empty())
+            m_qi_profiler = alloc(qi_profiler, m);
     }
 
     /**
@@ -119,6 +122,8 @@ namespace smt {
         m_asserted_formulas.updt_params(p);
         if (!m_setup.already_configured()) {
             m_fparams.updt_params(p);
+            if (!m_qi_profiler && !m_fparams.m_qi_profile_file.empty())
+                m_qi_profiler = alloc(qi_profiler, m);
         }
     }
 
@@ -126,7 +131,7 @@ namespace smt {
         return std::min(m_relevancy_lvl, m_fparams.m_relevancy_lvl);
     }
 
-    void context::copy(context& src_ctx, context& dst_ctx, bool override_base) {
+    void context::copy(context& src_ctx, context& dst_ctx, bool override_base, bool copy_lemmas) {
         ast_manager& dst_m = dst_ctx.get_manager();
         ast_manager& src_m = src_ctx.get_manager();
         src_ctx.pop_to_base_lvl();
@@ -182,11 +187,43 @@ namespace smt {
         
         dst_ctx.copy_user_propagator(src_ctx, true);
 
+        if (copy_lemmas)
+            dst_ctx.copy_lemmas(src_ctx, tr);
+
         TRACE("smt_context",
               src_ctx.display(tout);
               dst_ctx.display(tout););
     }
 
+    /**
+       \brief Copy the lemmas of src whose atoms are internalized in this context
+       and are safe to copy for their theories.
+       src is at base level and its assertions were copied, so the lemmas are
+       consequences of the assertions of this context.
+    */
+    void context::copy_lemmas(context& src_ctx, ast_translation& tr) {
+        if (m.proofs_enabled())
+            return;
+        literal_vector lits;
+        for (clause* cls : src_ctx.m_lemmas) {
+            if (inconsistent())
+                break;
+            lits.reset();
+            for (literal l : *cls) {
+                bool_var_data const & d = src_ctx.get_bdata(l.var());
+                if (d.is_theory_atom() && !src_ctx.m_theories.get_plugin(d.get_theory())->is_safe_to_copy(l.var()))
+                    break;
+                expr_ref atom(tr(src_ctx.bool_var2expr(l.var())), m);
+                if (!b_internalized(atom))
+                    break;
+                lits.push_back(literal(get_bool_var(atom), l.sign()));
+            }
+            if (lits.size() == cls->get_num_literals())
+                mk_clause(lits.size(), lits.data(), nullptr, CLS_TH_LEMMA);
+        }
+        TRACE("smt_context", tout << "copied lemmas: " << m_lemmas.size() << " of " << src_ctx.m_lemmas.size() << "\n";);
+    }
+
     context::~context() {
         flush();
         m_asserted_formulas.finalize();
@@ -3514,6 +3551,8 @@ namespace smt {
               );
         m_search_finalized = true;
         display_profile(verbose_stream());
+        if (m_qi_profiler)
+            m_qi_profiler->write(m_fparams.m_qi_profile_file);
         if (r == l_true && get_cancel_flag()) 
             r = l_undef;
         if (r == l_undef && m_internal_completed == l_true && has_sls_model()) {
@@ -4201,6 +4240,17 @@ namespace smt {
             if (delay_forced_restart) {
                 new_lvl = conflict_lvl - 1;
             }
+            else if (m_fparams.m_chrono_backtrack > 0 &&
+                     num_lits > 1 &&
+                     m_scope_lvl - new_lvl > m_fparams.m_chrono_backtrack &&
+                     conflict_lvl - 1 > new_lvl) {
+                // Chronological backtracking: undoing many scopes throws away
+                // E-graph merges and theory state that have to be re-derived.
+                // Backtrack only the conflict level instead. The lemma is still
+                // asserting, lits[0] is just assigned at a higher level than needed.
+                new_lvl = conflict_lvl - 1;
+                m_stats.m_num_chrono_backtracks++;
+            }
 
             // Some of the literals/enodes of the conflict clause will be destroyed during
             // backtracking, and will need to be recreated. However, I want to keep
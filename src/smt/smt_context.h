@@ -30,6 +30,7 @@ Revision History:
 #include "smt/smt_clause_proof.h"
 #include "smt/smt_theory.h"
 #include "smt/smt_quantifier.h"
+#include "smt/qi_profiler.h"
 #include "smt/smt_statistics.h"
 #include "smt/smt_conflict_resolution.h"
 #include "smt/smt_relevancy.h"
@@ -58,6 +59,8 @@ Revision History:
 // consumption.
 #define USE_BOOL_VAR_VECTOR 1
 
+class ast_translation;
+
 namespace smt {
 
     class model_generator;
@@ -105,6 +108,7 @@ namespace smt {
         scoped_ptr<quantifier_manager>   m_qmanager;
         scoped_ptr<model_generator>      m_model_generator;
         scoped_ptr<relevancy_propagator> m_relevancy_propagator;
+        scoped_ptr<qi_profiler>          m_qi_profiler;
         theory_user_propagator*          m_user_propagator;
         random_gen                  m_random;
         bool                        m_flushing; // (debug support) true when flushing
@@ -1171,6 +1175,10 @@ namespace smt {
             return m_num_conflicts;
         }
 
+        qi_profiler* get_qi_profiler() const {
+            return m_qi_profiler.get();
+        }
+
         static bool is_eq(enode const * n1, enode const * n2) { return n1->get_root() == n2->get_root(); }
 
         bool is_diseq(enode * n1, enode * n2) const;
@@ -1649,7 +1657,9 @@ namespace smt {
         */
         context * mk_fresh(symbol const * l = nullptr,  smt_params * smtp = nullptr, params_ref const & p = params_ref());
 
-        static void copy(context& src, context& dst, bool override_base = false);
+        static void copy(context& src, context& dst, bool override_base = false, bool copy_lemmas = false);
+
+        void copy_lemmas(context& src, ast_translation& tr);
 
         /**
            \brief Translate context to use new manager m.
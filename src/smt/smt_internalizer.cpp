@@ -951,6 +951,8 @@ namespace smt {
         else
             m_activity[v]      = 0.0;
         m_case_split_queue->mk_var_eh(v);
+        if (m_qi_profiler)
+            m_qi_profiler->on_mk_bool_var(v);
         m_b_internalized_stack.push_back(n);
         m_trail_stack.push_back(&m_mk_bool_var_trail);
         m_stats.m_num_mk_bool_var++;
@@ -1001,6 +1003,8 @@ namespace smt {
         TRACE("mk_var_bug", tout << "mk_enode: " << id << "\n";);
         TRACE("generation", tout << "mk_enode: " << id << " " << generation << "\n";);
         m_app2enode.setx(id, e, nullptr);
+        if (m_qi_profiler)
+            m_qi_profiler->on_mk_enode(e);
         m_e_internalized_stack.push_back(n);
         m_trail_stack.push_back(&m_mk_enode_trail);
         m_enodes.push_back(e);
@@ -64,8 +64,8 @@ namespace smt {
         return m_imp->m_kernel.get_manager();
     }
 
-    void  kernel::copy(kernel& src, kernel& dst, bool override_base) {
-        context::copy(src.m_imp->m_kernel, dst.m_imp->m_kernel, override_base);
+    void  kernel::copy(kernel& src, kernel& dst, bool override_base, bool copy_lemmas) {
+        context::copy(src.m_imp->m_kernel, dst.m_imp->m_kernel, override_base, copy_lemmas);
     }
 
     bool kernel::set_logic(symbol logic) {
@@ -50,7 +50,7 @@ namespace smt {
 
         ~kernel();
 
-        static void copy(kernel& src, kernel& dst, bool override_base);
+        static void copy(kernel& src, kernel& dst, bool override_base, bool copy_lemmas = false);
 
         ast_manager & m() const;
         
@@ -30,11 +30,15 @@ Revision History:
 #include "ast/array_decl_plugin.h"
 #include "ast/special_relations_decl_plugin.h"
 #include "ast/ast_smt2_pp.h"
+#include "ast/ast_translation.h"
 #include "smt/smt_model_checker.h"
 #include "smt/smt_context.h"
 #include "smt/smt_model_finder.h"
 #include "model/model_pp.h"
 #include <tuple>
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 namespace smt {
 
@@ -140,29 +144,27 @@ namespace smt {
     }
 
     /**
-       \brief Assert in m_aux_context, the constraint
+       \brief Add to fmls the constraint
 
          sk = e_1 OR ... OR sk = e_n
 
          where {e_1, ..., e_n} is the universe.
      */
-    void model_checker::restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe) {
+    void model_checker::restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe, expr_ref_vector & fmls) {
         SASSERT(!universe.empty());
         ptr_buffer<expr> eqs;
         for (expr * e : universe) {
             eqs.push_back(m.mk_eq(sk, e));
         }
-        expr_ref fml(m.mk_or(eqs.size(), eqs.data()), m);
-        m_aux_context->assert_expr(fml);
+        fmls.push_back(m.mk_or(eqs.size(), eqs.data()));
     }
 
     /**
-       \brief Assert the negation of q after applying the interpretation in m_curr_model to the uninterpreted symbols in q.
+       \brief Collect in fmls the negation of q after applying the interpretation in m_curr_model to the uninterpreted symbols in q.
 
        The variables are replaced by skolem constants. These constants are stored in sks.
     */
-
-    bool model_checker::assert_neg_q_m(quantifier * q, expr_ref_vector & sks) {
+    bool model_checker::mk_neg_q_m(quantifier * q, expr_ref_vector & sks, expr_ref_vector & fmls) {
         expr_ref tmp(m);
         
         TRACE("model_checker", tout << "curr_model:\n"; model_pp(tout, *m_curr_model););
@@ -181,7 +183,7 @@ namespace smt {
             sks[num_decls - i - 1]        = sk;
             subst_args[num_decls - i - 1] = sk;
             if (m_curr_model->is_finite(s)) {
-                restrict_to_universe(sk, m_curr_model->get_known_universe(s));
+                restrict_to_universe(sk, m_curr_model->get_known_universe(s), fmls);
             }
         }
 
@@ -190,7 +192,7 @@ namespace smt {
         expr_ref r(m);
         r = m.mk_not(sk_body);
         TRACE("model_checker", tout << "mk_neg_q_m:\n" << mk_ismt2_pp(r, m) << "\n";);
-        m_aux_context->assert_expr(r);
+        fmls.push_back(r);
         return true;
     }
 
@@ -343,28 +345,37 @@ namespace smt {
     */
 
     bool model_checker::check(quantifier * q) {
+        expr_ref_vector sks(m), fmls(m);
+        if (!mk_neg_q_m(get_flat_quantifier(q), sks, fmls))
+            return false;
+        return check(q, sks, fmls, nullptr);
+    }
+
+    /**
+       \brief Check q, where fmls is the negation of q in the current model
+       and sks are its skolem constants. known_cex is a model of fmls
+       found by check_parallel, or null if fmls has not been checked yet.
+    */
+    bool model_checker::check(quantifier * q, expr_ref_vector & sks, expr_ref_vector const & fmls, model * known_cex) {
         SASSERT(!m_aux_context->relevancy());
         scoped_ctx_push _push(m_aux_context.get());
 
-        quantifier * flat_q = get_flat_quantifier(q);
-        TRACE("model_checker", tout << "model checking:\n" << expr_ref(flat_q->get_expr(), m) << "\n";);
-        expr_ref_vector sks(m);
-
-        if (!assert_neg_q_m(flat_q, sks))
-            return false;
+        TRACE("model_checker", tout << "model checking:\n" << expr_ref(get_flat_quantifier(q)->get_expr(), m) << "\n";);
+        for (expr * f : fmls)
+            m_aux_context->assert_expr(f);
         TRACE("model_checker", tout << "skolems:\n" << sks << "\n";);
 
-        flet<bool> l(m_aux_context->get_fparams().m_array_fake_support, true);
-        lbool r = m_aux_context->check();
-        
-        TRACE("model_checker", tout << "[complete] model-checker result: " << to_sat_str(r) << "\n";);
-        if (r != l_true) {
-            return is_safe_for_mbqi(q) && r == l_false; // quantifier is satisfied by m_curr_model
+        model_ref complete_cex = known_cex;
+        if (!complete_cex) {
+            flet<bool> l(m_aux_context->get_fparams().m_array_fake_support, true);
+            lbool r = m_aux_context->check();
+            TRACE("model_checker", tout << "[complete] model-checker result: " << to_sat_str(r) << "\n";);
+            if (r != l_true) {
+                return is_safe_for_mbqi(q) && r == l_false; // quantifier is satisfied by m_curr_model
+            }
+            m_aux_context->get_model(complete_cex);
         }
 
-        model_ref complete_cex;
-        m_aux_context->get_model(complete_cex);
-
         // try to find new instances using instantiation sets.
         m_model_finder.restrict_sks_to_inst_set(m_aux_context.get(), q, sks);
 
@@ -514,7 +525,20 @@ namespace smt {
     // using multi-patterns.
     //
 
+    /**
+       \brief The negation of a quantifier in the current model, checked by
+       check_parallel. m_cex is a model of m_fmls if m_result is l_true.
+    */
+    struct model_checker::neg_q {
+        expr_ref_vector m_sks;
+        expr_ref_vector m_fmls;
+        lbool           m_result = l_undef;
+        model_ref       m_cex;
+        neg_q(ast_manager & m): m_sks(m), m_fmls(m) {}
+    };
+
     void model_checker::check_quantifiers(bool& found_relevant, unsigned& num_failures) {
+        ptr_vector<quantifier> qs;
         for (quantifier * q : *m_qm) {
             if (!(m_qm->mbqi_enabled(q) &&
                   m_context->is_relevant(q) &&
@@ -524,7 +548,15 @@ namespace smt {
                     ++num_failures;
                 continue;
             }
+            qs.push_back(q);
+        }
 
+        scoped_ptr_vector<neg_q> negs;
+        if (m_params.m_mbqi_threads > 1 && qs.size() > 1)
+            check_parallel(qs, negs);
+
+        for (unsigned i = 0; i < qs.size(); ++i) {
+            quantifier * q = qs[i];
             TRACE("model_checker",
                   tout << "Check: " << mk_pp(q, m) << "\n";
                   tout << m_context->get_assignment(q) << "\n";);
@@ -533,7 +565,15 @@ namespace smt {
                 IF_VERBOSE(1, verbose_stream() << "(smt.mbqi :checking " << q->get_qid() << ")\n");
             }
             found_relevant = true;
-            if (!check(q)) {
+            neg_q * n = i < negs.size() ? negs[i] : nullptr;
+            bool ok;
+            if (!n)
+                ok = check(q);
+            else if (n->m_result == l_false)
+                ok = is_safe_for_mbqi(q); // quantifier is satisfied by m_curr_model
+            else
+                ok = !n->m_fmls.empty() && check(q, n->m_sks, n->m_fmls, n->m_cex.get());
+            if (!ok) {
                 if (m_params.m_mbqi_trace || get_verbosity_level() >= 5) {
                     IF_VERBOSE(0, verbose_stream() << "(smt.mbqi :failed " << q->get_qid() << ")\n");
                 }
@@ -543,9 +583,109 @@ namespace smt {
         }
     }
 
+    /**
+       \brief Check the negations of the quantifiers in qs against the
+       current model in parallel. Each thread owns a manager and a
+       context, which are kept until the next search. The formulas are
+       built up front and quantifier i is checked by thread i % num_threads,
+       so the results do not depend on scheduling. negs[i] holds the
+       negation of qs[i] with the result of the check. check(q, ...)
+       reuses it, so that a counter-example is not searched for twice.
+    */
+    void model_checker::check_parallel(ptr_vector<quantifier> const & qs, scoped_ptr_vector<neg_q> & negs) {
+#ifndef SINGLE_THREAD
+        if (m.has_trace_stream() || !m.inc())
+            return;
+        unsigned num_threads = std::min(m_params.m_mbqi_threads, qs.size());
+        if (num_threads <= 1)
+            return;
+
+        while (m_par_contexts.size() < num_threads) {
+            smt_params * fp = alloc(smt_params, *m_fparams);
+            fp->m_array_fake_support = true;
+            m_par_fparams.push_back(fp);
+            ast_manager * new_m = alloc(ast_manager, m, true);
+            m_par_managers.push_back(new_m);
+            m_par_contexts.push_back(alloc(context, *new_m, *fp));
+        }
+        scoped_limits sl(m.limit());
+        for (unsigned t = 0; t < num_threads; ++t) {
+            m_par_managers[t]->limit().reset_cancel();
+            sl.push_child(&(m_par_managers[t]->limit()));
+        }
+
+        vector<expr_ref_vector> pfmls;
+        vector<model_ref> pmodels;
+        for (unsigned i = 0; i < qs.size(); ++i) {
+            ast_manager & tm = *m_par_managers[i % num_threads];
+            neg_q * n = alloc(neg_q, m);
+            negs.push_back(n);
+            pfmls.push_back(expr_ref_vector(tm));
+            pmodels.push_back(model_ref());
+            if (!mk_neg_q_m(get_flat_quantifier(qs[i]), n->m_sks, n->m_fmls))
+                continue;
+            ast_translation tr(m, tm);
+            for (expr * f : n->m_fmls)
+                pfmls.back().push_back(tr(f));
+        }
+
+        bool_vector failed(num_threads, false);
+        auto worker = [&](unsigned t) {
+            context & ctx = *m_par_contexts[t];
+            for (unsigned i = t; i < qs.size(); i += num_threads) {
+                if (pfmls[i].empty())
+                    continue;
+                try {
+                    ctx.push();
+                    for (expr * f : pfmls[i])
+                        ctx.assert_expr(f);
+                    lbool r = ctx.check();
+                    if (r == l_true)
+                        ctx.get_model(pmodels[i]);
+                    negs[i]->m_result = r;
+                    ctx.pop(1);
+                }
+                catch (z3_exception &) {
+                    negs[i]->m_result = l_undef;
+                    failed[t] = true;
+                    return;
+                }
+            }
+        };
+
+        vector<std::thread> threads;
+        for (unsigned t = 0; t < num_threads; ++t)
+            threads.push_back(std::thread([&, t]() { worker(t); }));
+        for (auto & th : threads)
+            th.join();
+
+        for (unsigned i = 0; i < qs.size(); ++i) {
+            if (negs[i]->m_result != l_true)
+                continue;
+            if (!pmodels[i]) {
+                negs[i]->m_result = l_undef;
+                continue;
+            }
+            ast_translation tr(*m_par_managers[i % num_threads], m);
+            negs[i]->m_cex = pmodels[i]->translate(tr);
+        }
+        pmodels.reset();
+        pfmls.reset();
+        // a context interrupted by an exception may be left inside a scope.
+        for (unsigned t = 0; t < num_threads; ++t)
+            if (failed[t])
+                m_par_contexts.set(t, alloc(context, *m_par_managers[t], *m_par_fparams[t]));
+        TRACE("model_checker", for (unsigned i = 0; i < qs.size(); ++i) tout << qs[i]->get_qid() << " " << negs[i]->m_result << "\n";);
+#endif
+    }
+
     void model_checker::init_search_eh() {
         m_max_cexs = m_params.m_mbqi_max_cexs;
         m_iteration_idx = 0;
+        // the managers of check_parallel are created from the signature of m as it is now.
+        m_par_contexts.reset();
+        m_par_managers.reset();
+        m_par_fparams.reset();
     }
 
     void model_checker::restart_eh() {
@@ -21,6 +21,7 @@ Revision History:
 #pragma once
 
 #include "util/obj_hashtable.h"
+#include "util/scoped_ptr_vector.h"
 #include "ast/ast.h"
 #include "ast/array_decl_plugin.h"
 #include "ast/normal_forms/defined_names.h"
@@ -53,6 +54,10 @@ namespace smt {
         proto_model *                               m_curr_model;
         obj_map<expr, expr *>                       m_value2expr;
         expr_ref_vector                             m_fresh_exprs;
+        // managers and contexts of the threads of check_parallel.
+        scoped_ptr_vector<smt_params>               m_par_fparams;
+        scoped_ptr_vector<ast_manager>              m_par_managers;
+        scoped_ptr_vector<context>                  m_par_contexts;
 
         friend class model_instantiation_set;
 
@@ -61,11 +66,14 @@ namespace smt {
         expr * get_term_from_ctx(expr * val);
         expr * get_type_compatible_term(expr * val);
         expr_ref replace_value_from_ctx(expr * e);
-        void restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe);
-        bool assert_neg_q_m(quantifier * q, expr_ref_vector & sks);
+        void restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe, expr_ref_vector & fmls);
+        bool mk_neg_q_m(quantifier * q, expr_ref_vector & sks, expr_ref_vector & fmls);
         bool add_blocking_clause(model * cex, expr_ref_vector & sks);
         bool check(quantifier * q);
+        bool check(quantifier * q, expr_ref_vector & sks, expr_ref_vector const & fmls, model * known_cex);
         void check_quantifiers(bool& found_relevant, unsigned& num_failures);
+        struct neg_q;
+        void check_parallel(ptr_vector<quantifier> const & qs, scoped_ptr_vector<neg_q> & negs);
 
         struct instance {
             quantifier * m_q;
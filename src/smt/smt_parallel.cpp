@@ -9,6 +9,13 @@ Abstract:
 
     Parallel SMT, portfolio loop specialized to SMT core.
 
+    Cube-and-conquer mode:
+    Workers pull cubes from a shared queue. A worker splits its cube
+    using lookahead when other workers are idle or when the conflict
+    budget for the cube is exhausted, and donates one half to the queue.
+    Refuted cubes contribute the negation of their core as a lemma to 
+    the other workers. The problem is unsat when all cubes are refuted.
+
 Author:
 
     nbjorner 2020-01-31
@@ -31,11 +38,18 @@ namespace smt {
     lbool parallel::operator()(expr_ref_vector const& asms) {
         return l_undef;
     }
+
+    lbool parallel::cube_and_conquer(expr_ref_vector const& asms, unsigned num_threads, unsigned conflict_budget) {
+        return l_undef;
+    }
 }
 
 #else
 
 #include <thread>
+#include <deque>
+#include <condition_variable>
+#include <chrono>
 
 namespace smt {
     
@@ -55,6 +69,9 @@ namespace smt {
             return result;
         }        
 
+        if (ctx.get_fparams().m_threads_cube_and_conquer)
+            return cube_and_conquer(asms, num_threads, thread_max_conflicts);
+
         enum par_exception_kind {
             DEFAULT_EX,
             ERROR_EX
@@ -262,5 +279,299 @@ namespace smt {
         return result;
     }
 
+
+    lbool parallel::cube_and_conquer(expr_ref_vector const& asms, unsigned num_threads, unsigned conflict_budget) {
+
+        enum par_exception_kind {
+            DEFAULT_EX,
+            ERROR_EX
+        };
+
+        vector<smt_params> smt_params;
+        scoped_ptr_vector<ast_manager> pms;
+        scoped_ptr_vector<context> pctxs;
+        vector<expr_ref_vector> pasms;
+
+        ast_manager& m = ctx.m;
+        scoped_limits sl(m.limit());
+        lbool result = l_undef;
+        unsigned finished_id = UINT_MAX;
+        std::string        ex_msg;
+        par_exception_kind ex_kind = DEFAULT_EX;
+        unsigned error_code = 0;
+        bool done = false;
+        bool has_exception = false;
+        if (m.has_trace_stream())
+            throw default_exception("trace streams have to be off in parallel mode");
+
+        conflict_budget = std::max(conflict_budget, 1u);
+
+        for (unsigned i = 0; i < num_threads; ++i) {
+            smt_params.push_back(ctx.get_fparams());
+        }
+        for (unsigned i = 0; i < num_threads; ++i) {
+            ast_manager* new_m = alloc(ast_manager, m, true);
+            pms.push_back(new_m);
+            pctxs.push_back(alloc(context, *new_m, smt_params[i], ctx.get_params())); 
+            context& new_ctx = *pctxs.back();
+            context::copy(ctx, new_ctx, true);
+            new_ctx.set_random_seed(i + ctx.get_fparams().m_random_seed);
+            ast_translation tr(m, *new_m);
+            pasms.push_back(tr(asms));
+            sl.push_child(&(new_m->limit()));
+        }
+
+        // 
+        // Shared state lives in the main manager m and is only accessed while holding mux.
+        // Cubes and lemmas are translated between m and the worker managers under the lock
+        // because translation updates reference counts of the source terms.
+        //
+        std::mutex mux;
+        std::condition_variable cv;
+        std::deque<expr_ref_vector> cubes;
+        expr_ref_vector lemmas(m);
+        expr_ref_vector core(m);
+        obj_hashtable<expr> asms_set, core_set;
+        unsigned num_idle = 0;
+        unsigned num_cubes = 0, num_refuted = 0;
+
+        for (expr* a : asms)
+            asms_set.insert(a);
+        cubes.push_back(expr_ref_vector(m));
+
+        // the worker that finished keeps its limit, so that its model can be retrieved.
+        auto cancel_others = [&](unsigned i) {
+            for (unsigned j = 0; j < num_threads; ++j)
+                if (j != i)
+                    pms[j]->limit().cancel();
+        };
+
+        // called with mux held.
+        auto set_done = [&](unsigned i, lbool r) {
+            if (done) 
+                return;
+            done = true;
+            finished_id = i;
+            result = r;
+            cv.notify_all();
+            cancel_others(i);
+        };
+
+        // returns false if there is no more work.
+        auto get_cube = [&](unsigned i, expr_ref_vector& cube) {
+            std::unique_lock<std::mutex> lock(mux);
+            ++num_idle;
+            if (num_idle == num_threads)
+                cv.notify_all();
+            // cancellation does not signal cv, so the wait polls the limit of the worker.
+            while (!done && cubes.empty() && num_idle < num_threads && !pms[i]->limit().is_canceled())
+                cv.wait_for(lock, std::chrono::milliseconds(100));
+            if (done)
+                return false;
+            if (pms[i]->limit().is_canceled()) {
+                set_done(i, l_undef);
+                return false;
+            }
+            if (cubes.empty()) {
+                // all workers are idle and all cubes are refuted.
+                set_done(UINT_MAX, l_false);
+                return false;
+            }
+            --num_idle;
+            ast_translation tr(m, cube.get_manager());
+            cube.reset();
+            for (expr* e : cubes.front())
+                cube.push_back(tr(e));
+            cubes.pop_front();
+            ++num_cubes;
+            return true;
+        };
+
+        auto has_idle = [&]() {
+            std::lock_guard<std::mutex> lock(mux);
+            return num_idle > 0 && cubes.empty();
+        };
+
+        auto import_lemmas = [&](unsigned i, unsigned& qhead) {
+            context& pctx = *pctxs[i];
+            expr_ref_vector new_lemmas(pctx.m);
+            {
+                std::lock_guard<std::mutex> lock(mux);
+                ast_translation tr(m, pctx.m);
+                for (; qhead < lemmas.size(); ++qhead) 
+                    new_lemmas.push_back(tr(lemmas.get(qhead)));
+            }
+            for (expr* e : new_lemmas)
+                pctx.assert_expr(e);
+        };
+
+        // 
+        // split the current cube on a lookahead literal.
+        // The worker keeps the positive half and donates the negative half.
+        // 
+        auto split_cube = [&](unsigned i, expr_ref_vector& cube) {
+            context& pctx = *pctxs[i];
+            ast_manager& pm = pctx.m;
+            pctx.push();
+            for (expr* e : cube)
+                pctx.assert_expr(e);
+            pctx.internalize_assertions();
+            pctx.propagate();
+            lookahead lh(pctx);
+            expr_ref lit = lh.choose();
+            pctx.pop(1);
+            if (!lit || pm.is_true(lit) || pm.is_false(lit))
+                return;
+            expr_ref_vector donated(cube);
+            donated.push_back(mk_not(lit));
+            cube.push_back(lit);
+            IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :split " << mk_bounded_pp(lit, pm, 3) << " :depth " << cube.size() << ")\n");
+            std::lock_guard<std::mutex> lock(mux);
+            ast_translation tr(pm, m);
+            cubes.push_back(expr_ref_vector(m));
+            for (expr* e : donated)
+                cubes.back().push_back(tr(e));
+            cv.notify_one();
+        };
+
+        // 
+        // returns true if the refutation depends on the cube.
+        // The core of the refutation is shared as a lemma.
+        // 
+        auto refute_cube = [&](unsigned i, expr_ref_vector const& cube) {
+            context& pctx = *pctxs[i];
+            expr_ref_vector const& pcore = pctx.unsat_core();
+            bool uses_cube = any_of(pcore, [&](expr* e) { return cube.contains(e); });
+            std::lock_guard<std::mutex> lock(mux);
+            ast_translation tr(pctx.m, m);
+            if (!uses_cube) {
+                core_set.reset();
+                core.reset();
+            }
+            for (expr* e : pcore) {
+                expr* ce = tr(e);
+                if (asms_set.contains(ce) && !core_set.contains(ce)) {
+                    core_set.insert(ce);
+                    core.push_back(ce);
+                }
+            }
+            if (!uses_cube) {
+                set_done(i, l_false);
+                return false;
+            }
+            ++num_refuted;
+            lemmas.push_back(tr(mk_not(mk_and(pcore)).get()));
+            IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :refuted " << num_refuted << "/" << num_cubes << " :core " << pcore.size() << ")\n");
+            return true;
+        };
+
+        auto worker_thread = [&](unsigned i) {
+            try {
+                context& pctx = *pctxs[i];
+                ast_manager& pm = *pms[i];
+                expr_ref_vector cube(pm), lasms(pm);
+                unsigned qhead = 0;
+                while (get_cube(i, cube)) {
+                    unsigned budget = conflict_budget;
+                    while (true) {
+                        import_lemmas(i, qhead);
+                        if (has_idle())
+                            split_cube(i, cube);
+                        lasms.reset();
+                        lasms.append(pasms[i]);
+                        lasms.append(cube);
+                        pctx.get_fparams().m_max_conflicts = budget;
+                        lbool r = pctx.check(lasms.size(), lasms.data());
+                        if (r == l_undef && !pm.inc()) {
+                            std::lock_guard<std::mutex> lock(mux);
+                            set_done(i, l_undef);
+                            return;
+                        }
+                        if (r == l_undef && pctx.m_num_conflicts >= budget) {
+                            budget = budget >= UINT_MAX / 2 ? UINT_MAX : 2 * budget;
+                            split_cube(i, cube);
+                            continue;
+                        }
+                        if (r == l_false && refute_cube(i, cube))
+                            break;
+                        if (r != l_false) {
+                            std::lock_guard<std::mutex> lock(mux);
+                            set_done(i, r);
+                        }
+                        return;
+                    }
+                }
+            }
+            catch (z3_error & err) {
+                std::lock_guard<std::mutex> lock(mux);
+                if (!done) {
+                    error_code = err.error_code();
+                    ex_kind = ERROR_EX;
+                    has_exception = true;
+                    set_done(i, l_undef);
+                }
+            }
+            catch (z3_exception & ex) {
+                std::lock_guard<std::mutex> lock(mux);
+                if (!done) {
+                    ex_msg = ex.what();
+                    ex_kind = DEFAULT_EX;
+                    has_exception = true;
+                    set_done(i, l_undef);
+                }
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mux);
+                if (!done) {
+                    ex_msg = "unknown exception";
+                    ex_kind = ERROR_EX;
+                    has_exception = true;
+                    set_done(i, l_undef);
+                }
+            }
+        };
+
+        vector<std::thread> threads(num_threads);
+        for (unsigned i = 0; i < num_threads; ++i) {
+            threads[i] = std::thread([&, i]() { worker_thread(i); });
+        }
+        for (auto & th : threads) {
+            th.join();
+        }
+
+        for (context* c : pctxs) {
+            c->collect_statistics(ctx.m_aux_stats);
+        }
+        ctx.m_aux_stats.update("smt.cubes", num_cubes);
+        ctx.m_aux_stats.update("smt.cubes refuted", num_refuted);
+
+        if (has_exception) {
+            switch (ex_kind) {
+            case ERROR_EX: throw z3_error(error_code);
+            default: throw default_exception(std::move(ex_msg));
+            }
+        }        
+
+        model_ref mdl;        
+        switch (result) {
+        case l_true: {
+            context& pctx = *pctxs[finished_id];
+            ast_translation tr(*pms[finished_id], m);
+            pctx.get_model(mdl);
+            if (mdl) 
+                ctx.set_model(mdl->translate(tr));            
+            break;
+        }
+        case l_false:
+            ctx.m_unsat_core.reset();
+            ctx.m_unsat_core.append(core);
+            break;
+        default:
+            break;
+        }                                
+
+        return result;
+    }
+
 }
 #endif
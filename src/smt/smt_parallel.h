@@ -8,6 +8,8 @@ Module Name:
 Abstract:
 
     Parallel SMT, portfolio loop specialized to SMT core.
+    Optionally, a cube-and-conquer mode where workers split cubes
+    using lookahead and donate halves to idle workers.
 
 Author:
 
@@ -24,6 +26,9 @@ namespace smt {
 
     class parallel {
         context& ctx;
+
+        lbool cube_and_conquer(expr_ref_vector const& asms, unsigned num_threads, unsigned conflict_budget);
+
     public:
         parallel(context& ctx): ctx(ctx) {}
 
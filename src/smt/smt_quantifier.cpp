@@ -300,6 +300,8 @@ namespace smt {
             get_stat(q)->update_max_generation(max_generation);
             fingerprint * f = m_context.add_fingerprint(q, q->get_id(), num_bindings, bindings, def);
             if (f) {
+                if (qi_profiler* p = m_context.get_qi_profiler())
+                    p->on_match(q, pat, num_bindings, bindings);
                 if (is_trace_enabled("causality")) {
                     log_causality(f,pat,used_enodes);
                 }
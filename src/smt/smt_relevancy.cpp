@@ -139,9 +139,12 @@ namespace smt {
             expr * get_node() const { return m_node; }
         };
         svector<eh_trail>              m_trail;
+        uint_set                       m_justified;       // or/and nodes that have a relevant child justifying their value
+        unsigned_vector                m_justified_trail;
         struct scope {
             unsigned m_relevant_exprs_lim;
             unsigned m_trail_lim;
+            unsigned m_justified_lim;
         };
         svector<scope>                 m_scopes;
         bool                           m_propagating = false;
@@ -253,6 +256,7 @@ namespace smt {
             scope & s                  = m_scopes.back();
             s.m_relevant_exprs_lim     = m_relevant_exprs.size();
             s.m_trail_lim              = m_trail.size();
+            s.m_justified_lim          = m_justified_trail.size();
         }
 
         void pop(unsigned num_scopes) override {
@@ -263,6 +267,7 @@ namespace smt {
             scope & s        = m_scopes[new_lvl];
             unmark_relevant_exprs(s.m_relevant_exprs_lim);
             undo_trail(s.m_trail_lim);
+            unmark_justified(s.m_justified_lim);
             m_scopes.shrink(new_lvl);
         }
 
@@ -282,6 +287,19 @@ namespace smt {
             m_qhead = m_relevant_exprs.size();
         }
 
+        void unmark_justified(unsigned old_lim) {
+            for (unsigned i = old_lim; i < m_justified_trail.size(); ++i)
+                m_justified.remove(m_justified_trail[i]);
+            m_justified_trail.shrink(old_lim);
+        }
+
+        bool is_justified(app * n) const { return m_justified.contains(n->get_id()); }
+
+        void set_justified(app * n) {
+            m_justified.insert(n->get_id());
+            m_justified_trail.push_back(n->get_id());
+        }
+
         void undo_trail(unsigned old_lim) {
             SASSERT(old_lim <= m_trail.size());
             ast_manager & m = get_manager();
@@ -361,10 +379,15 @@ namespace smt {
         
         /**
            \brief Propagate relevancy for an or-application.
+
+           Once a true child is relevant (or all children are, when n is
+           false), n is justified until backtracking, and further
+           assignments to its children are ignored without scanning them.
         */
         void propagate_relevant_or(app * n) {
             SASSERT(get_manager().is_or(n));
-            
+            if (is_justified(n))
+                return;
             lbool val    = m_context.find_assignment(n);
             // If val is l_undef, then the expression
             // is a root, and no boolean variable was created for it.
@@ -373,6 +396,7 @@ namespace smt {
             switch (val) {
             case l_false:
                 propagate_relevant_app(n);
+                set_justified(n);
                 break;
             case l_undef:
                 break;
@@ -380,42 +404,54 @@ namespace smt {
                 expr * true_arg = nullptr;
                 for (expr* arg : *n) {
                     if (m_context.find_assignment(arg) == l_true) {
-                        if (is_relevant_core(arg))
+                        if (is_relevant_core(arg)) {
+                            set_justified(n);
                             return;
+                        }
                         else if (!true_arg)
                             true_arg = arg;
                     }
                 }
-                if (true_arg)
+                if (true_arg) {
                     mark_as_relevant(true_arg);
+                    set_justified(n);
+                }
                 break;
             } }
         }
         
         /**
            \brief Propagate relevancy for an and-application.
+           Dual of propagate_relevant_or.
         */
         void propagate_relevant_and(app * n) {
+            if (is_justified(n))
+                return;
             lbool val    = m_context.find_assignment(n);
             switch (val) {
             case l_false: {
                 expr * false_arg = nullptr;
                 for (expr* arg : *n) {
                     if (m_context.find_assignment(arg) == l_false) {
-                        if (is_relevant_core(arg))
-                            return; 
+                        if (is_relevant_core(arg)) {
+                            set_justified(n);
+                            return;
+                        }
                         else if (!false_arg)
                             false_arg = arg;
                     }
                 }
-                if (false_arg)
+                if (false_arg) {
                     mark_as_relevant(false_arg);
+                    set_justified(n);
+                }
                 break;
             }
             case l_undef:
                 break;
             case l_true:
                 propagate_relevant_app(n);
+                set_justified(n);
                 break;
             }
         }
@@ -85,10 +85,18 @@ namespace {
         }
 
         solver * translate(ast_manager & m, params_ref const & p) override {
+            return clone(m, p, false);
+        }
+
+        solver * fork(params_ref const & p) override {
+            return clone(get_manager(), p, true);
+        }
+
+        solver * clone(ast_manager & m, params_ref const & p, bool copy_lemmas) {
             ast_translation translator(get_manager(), m);
 
             smt_solver * result = alloc(smt_solver, m, p, m_logic);
-            smt::kernel::copy(m_context, result->m_context, true);
+            smt::kernel::copy(m_context, result->m_context, true, copy_lemmas);
 
             if (mc0()) 
                 result->set_model_converter(mc0()->translate(translator));
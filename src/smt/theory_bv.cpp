@@ -473,6 +473,8 @@ namespace smt {
     void theory_bv::fixed_var_eh(theory_var v) {
         numeral val;
         VERIFY(get_fixed_value(v, val));
+        if (!m_delayed.empty())
+            m_check_delayed = true;
         enode* n = get_enode(v);
         if (ctx.watches_fixed(n)) {
             expr_ref num(m_util.mk_numeral(val, n->get_expr()->get_sort()), m);
@@ -893,6 +895,10 @@ namespace smt {
         if (approximate_term(term)) {
             return false;
         }
+        if (should_delay(term)) {
+            internalize_delayed(term);
+            return true;
+        }
         switch (term->get_decl_kind()) {
         case OP_BV_NUM:         internalize_num(term); return true;
         case OP_BNEG:           internalize_neg(term); return true;
@@ -968,6 +974,166 @@ namespace smt {
         }
     }
 
+    /**
+       \brief With bv.delay, multipliers and dividers with at least two
+       non-constant arguments are not bit-blasted when they are internalized.
+       Their bits are fresh and checked against the values of the arguments
+       once these are fixed, see check_delayed.
+    */
+    bool theory_bv::should_delay(app * n) const {
+        if (!params().m_bv_delay || !params().m_bv_reflect)
+            return false;
+        switch (n->get_decl_kind()) {
+        case OP_BMUL:
+        case OP_BUDIV_I:
+        case OP_BUREM_I:
+        case OP_BSDIV_I:
+        case OP_BSREM_I:
+        case OP_BSMOD_I:
+            break;
+        default:
+            return false;
+        }
+        if (get_bv_size(n) <= 12)
+            return false;
+        unsigned num_vars = 0;
+        for (expr * arg : *n)
+            if (!m.is_value(arg))
+                ++num_vars;
+        return num_vars >= 2;
+    }
+
+    void theory_bv::internalize_delayed(app * n) {
+        SASSERT(!ctx.e_internalized(n));
+        process_args(n);
+        enode * e = mk_enode(n);
+        mk_bits(e->get_th_var(get_id()));
+        m_delayed.push_back(delayed_term(e));
+        ctx.push_trail(push_back_vector<svector<delayed_term>>(m_delayed));
+    }
+
+    bool theory_bv::check_delayed(bool is_final) {
+        bool ok = true;
+        for (unsigned i = 0; i < m_delayed.size() && !ctx.inconsistent(); ++i)
+            if (!check_delayed(i, is_final))
+                ok = false;
+        return ok;
+    }
+
+    /**
+       \brief Evaluate a delayed term on the fixed values of its arguments.
+       If the bits of the term disagree, add the lemma
+
+            args = values => bit_j(n) = value_j
+
+       for the bits that disagree. After a few such lemmas the term is
+       bit-blasted. Outside of final check only terms whose arguments
+       are fixed are considered and terms are not bit-blasted.
+       Terms that are bit-blasted in the current scope are skipped.
+    */
+    bool theory_bv::check_delayed(unsigned idx, bool is_final) {
+        const unsigned max_lemmas = 8;
+        delayed_term & d = m_delayed[idx];
+        enode * e = d.m_enode;
+        if (d.m_blasted || !ctx.is_relevant(e))
+            return true;
+        app * n = e->get_expr();
+        unsigned sz = get_bv_size(n);
+        numeral val;
+        expr_ref_vector args(m);
+        literal_vector lits;
+        for (unsigned i = 0; i < e->get_num_args(); ++i) {
+            theory_var w = get_arg_var(e, i);
+            if (!get_fixed_value(w, val)) {
+                if (!is_final)
+                    return true;
+                blast_delayed(idx);
+                return false;
+            }
+            args.push_back(m_util.mk_numeral(val, sz));
+            for (literal b : m_bits[w])
+                lits.push_back(ctx.get_assignment(b) == l_true ? ~b : b);
+        }
+        expr_ref r(m.mk_app(n->get_decl(), args), m);
+        ctx.get_rewriter()(r);
+        if (!m_util.is_numeral(r, val)) {
+            blast_delayed(idx);
+            return false;
+        }
+        literal_vector bits(m_bits[e->get_th_var(get_id())]);
+        unsigned_vector diff;
+        for (unsigned j = 0; j < sz; ++j)
+            if (ctx.get_assignment(bits[j]) != (val.get_bit(j) ? l_true : l_false))
+                diff.push_back(j);
+        if (diff.empty())
+            return true;
+        if (d.m_num_lemmas >= max_lemmas) {
+            if (!is_final)
+                return true;
+            blast_delayed(idx);
+            return false;
+        }
+        TRACE("bv", tout << "delayed " << mk_bounded_pp(n, m) << " evaluates to " << val << "\n";);
+        ++d.m_num_lemmas;
+        ++m_stats.m_num_delay_lemmas;
+        for (unsigned j : diff) {
+            lits.push_back(val.get_bit(j) ? bits[j] : ~bits[j]);
+            ctx.mk_th_axiom(get_id(), lits);
+            lits.pop_back();
+        }
+        return false;
+    }
+
+    /**
+       \brief Bit-blast a delayed term. The circuit is removed when the
+       scope is popped. A term that is bit-blasted above the search level
+       is bit-blasted again once search returns to the search level, so that
+       the circuit is not removed and added again on every backjump.
+    */
+    void theory_bv::blast_delayed(unsigned idx) {
+        ctx.push_trail(vector_value_trail<delayed_term, false>(m_delayed, idx));
+        m_delayed[idx].m_blasted = true;
+        if (!ctx.at_search_level())
+            m_blast_at_search_lvl.push_back(idx);
+        enode * e = m_delayed[idx].m_enode;
+        app * n = e->get_expr();
+        unsigned sz = get_bv_size(n);
+        expr_ref_vector arg1_bits(m), arg2_bits(m), bits(m);
+        TRACE("bv", tout << "bit-blast delayed " << mk_bounded_pp(n, m) << "\n";);
+        if (m_util.is_bv_mul(n)) {
+            unsigned i = n->get_num_args() - 1;
+            get_arg_bits(e, i, bits);
+            while (i > 0) {
+                --i;
+                arg1_bits.reset();
+                arg2_bits.reset();
+                get_arg_bits(e, i, arg1_bits);
+                m_bb.mk_multiplier(sz, arg1_bits.data(), bits.data(), arg2_bits);
+                bits.swap(arg2_bits);
+            }
+        }
+        else {
+            get_arg_bits(e, 0, arg1_bits);
+            get_arg_bits(e, 1, arg2_bits);
+            switch (n->get_decl_kind()) {
+            case OP_BUDIV_I: m_bb.mk_udiv(sz, arg1_bits.data(), arg2_bits.data(), bits); break;
+            case OP_BUREM_I: m_bb.mk_urem(sz, arg1_bits.data(), arg2_bits.data(), bits); break;
+            case OP_BSDIV_I: m_bb.mk_sdiv(sz, arg1_bits.data(), arg2_bits.data(), bits); break;
+            case OP_BSREM_I: m_bb.mk_srem(sz, arg1_bits.data(), arg2_bits.data(), bits); break;
+            case OP_BSMOD_I: m_bb.mk_smod(sz, arg1_bits.data(), arg2_bits.data(), bits); break;
+            default: UNREACHABLE(); return;
+            }
+        }
+        ctx.internalize(bits.data(), sz, true);
+        literal_vector out(m_bits[e->get_th_var(get_id())]);
+        for (unsigned j = 0; j < sz; ++j) {
+            literal l = ctx.get_literal(bits.get(j));
+            ctx.mk_th_axiom(get_id(), ~out[j], l);
+            ctx.mk_th_axiom(get_id(), out[j], ~l);
+        }
+        ++m_stats.m_num_delay_blasts;
+    }
+
 #define MK_NO_OVFL(NAME, OP)                                                                                    \
     void theory_bv::NAME(app *n) {                                                                              \
         SASSERT(n->get_num_args() == 2);                                                                        \
@@ -1452,6 +1618,8 @@ namespace smt {
 
     final_check_status theory_bv::final_check_eh() {
         SASSERT(check_invariant());
+        if (!check_delayed(true))
+            return FC_CONTINUE;
         if (m_approximates_large_bvs) {
             return FC_GIVEUP;
         }
@@ -1461,6 +1629,8 @@ namespace smt {
     void theory_bv::reset_eh() {
         pop_scope_eh(m_trail_stack.get_num_scopes());
         m_bool_var2atom.reset();
+        m_delayed.reset();
+        m_blast_at_search_lvl.reset();
         m_fixed_var_table.reset();
         theory::reset_eh();
     }
@@ -1650,8 +1820,29 @@ namespace smt {
         return true;
     }
 
+    bool theory_bv::can_propagate() {
+        return
+            m_prop_diseqs_qhead < m_prop_diseqs.size() ||
+            m_check_delayed ||
+            (!m_blast_at_search_lvl.empty() && ctx.at_search_level());
+    }
+
+    void theory_bv::blast_at_search_lvl() {
+        SASSERT(ctx.at_search_level());
+        for (unsigned idx : m_blast_at_search_lvl)
+            if (idx < m_delayed.size() && !m_delayed[idx].m_blasted)
+                blast_delayed(idx);
+        m_blast_at_search_lvl.reset();
+    }
+
     void theory_bv::propagate() {
-        if (!can_propagate())
+        if (!m_blast_at_search_lvl.empty() && ctx.at_search_level())
+            blast_at_search_lvl();
+        if (m_check_delayed) {
+            m_check_delayed = false;
+            check_delayed(false);
+        }
+        if (m_prop_diseqs_qhead >= m_prop_diseqs.size())
             return;
         ctx.push_trail(value_trail<unsigned>(m_prop_diseqs_qhead));
         for (; m_prop_diseqs_qhead < m_prop_diseqs.size() && !ctx.inconsistent(); ++m_prop_diseqs_qhead) {
@@ -1886,6 +2077,8 @@ namespace smt {
         st.update("bv bit2core", m_stats.m_num_bit2core);
         st.update("bv->core eq", m_stats.m_num_th2core_eq);
         st.update("bv dynamic eqs", m_stats.m_num_eq_dynamic);
+        st.update("bv delay lemmas", m_stats.m_num_delay_lemmas);
+        st.update("bv delay blasts", m_stats.m_num_delay_blasts);
     }
 
     theory_bv::var_enode_pos theory_bv::get_bv_with_theory(bool_var v, theory_id id) const {
@@ -30,7 +30,7 @@ namespace smt {
     
     struct theory_bv_stats {
         unsigned   m_num_diseq_static, m_num_diseq_dynamic, m_num_bit2core, m_num_th2core_eq, m_num_conflicts;
-        unsigned   m_num_eq_dynamic;
+        unsigned   m_num_eq_dynamic, m_num_delay_lemmas, m_num_delay_blasts;
         void reset() { memset(this, 0, sizeof(theory_bv_stats)); }
         theory_bv_stats() { reset(); }
     };
@@ -139,6 +139,17 @@ namespace smt {
         svector<var_pos>         m_prop_queue;
         bool                     m_approximates_large_bvs;
 
+        // multipliers and dividers whose circuits are delayed, see bv.delay
+        struct delayed_term {
+            enode *  m_enode;
+            unsigned m_num_lemmas = 0;
+            bool     m_blasted = false;      // reset on backtracking together with the circuit
+            delayed_term(enode * n): m_enode(n) {}
+        };
+        svector<delayed_term>    m_delayed;
+        unsigned_vector          m_blast_at_search_lvl;  // terms blasted above the search level
+        bool                     m_check_delayed = false;
+
         theory_var find(theory_var v) const { return m_find.find(v); }
         theory_var next(theory_var v) const { return m_find.next(v); }
         bool is_root(theory_var v) const { return m_find.is_root(v); }
@@ -220,6 +231,13 @@ namespace smt {
 
         bool approximate_term(app* n);
 
+        bool should_delay(app * n) const;
+        void internalize_delayed(app * n);
+        bool check_delayed(unsigned idx, bool is_final);
+        bool check_delayed(bool is_final);
+        void blast_delayed(unsigned idx);
+        void blast_at_search_lvl();
+
         template<bool Signed>
         void internalize_le(app * atom);
         bool internalize_xor3(app * n, bool gate_ctx);
@@ -249,7 +267,7 @@ namespace smt {
         bool include_func_interp(func_decl* f) override;
         svector<theory_var>   m_merge_aux[2]; //!< auxiliary vector used in merge_zero_one_bits
         bool merge_zero_one_bits(theory_var r1, theory_var r2);
-        bool can_propagate() override { return m_prop_diseqs_qhead < m_prop_diseqs.size(); }
+        bool can_propagate() override;
         void propagate() override;
         void initialize_value(expr* var, expr* value) override;
 
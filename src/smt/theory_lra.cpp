@@ -43,6 +43,7 @@
 #include "ast/converters/generic_model_converter.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
+#include "ast/ast_util.h"
 #include "util/cancel_eh.h"
 #include "util/scoped_timer.h"
 #include "util/distribution.h"
@@ -836,7 +837,8 @@ public:
         m_bounded_range_idx(0),
         m_bounded_range_lit(null_literal),
         m_bound_terms(m),
-        m_bound_predicate(m)
+        m_bound_predicate(m),
+        m_cached_lemmas(m)
     {
         m_bound_params.push_back(parameter(m_farkas));
         m_bound_params.push_back(parameter(rational(1)));
@@ -928,6 +930,7 @@ public:
         m_bounds_trail.push_back(v);
         m_bool_var2bound.insert(bv, b);
         mk_bound_axioms(*b);
+        add_cached_lemmas(atom);
         TRACE("arith_internalize", tout << "Internalized " << bv << ": " << bpp(atom) << "\n";);
         return true;
     }
@@ -1933,6 +1936,13 @@ public:
                   ctx().display_lemma_as_smt_problem(tout << "new cut:\n", m_core.size(), m_core.data(), m_eqs.size(), m_eqs.data(), lit);
                   display(tout););
             assign(lit, m_core, m_eqs, m_params);
+            if (m_eqs.empty()) {
+                literal_vector lemma;
+                for (literal c : m_core)
+                    lemma.push_back(~c);
+                lemma.push_back(lit);
+                cache_lemma(lemma, true);
+            }
             return FC_CONTINUE;
         }
         case lp::lia_move::conflict:
@@ -3479,6 +3489,7 @@ public:
                     return;
             }
             TRACE("arith", ctx().display_literals_verbose(tout, m_core) << "\n";);
+            cache_lemma(m_core);
             ctx().mk_th_axiom(get_id(), m_core.size(), m_core.data());
         }
     }
@@ -4163,6 +4174,75 @@ public:
         m_bound_predicate = nullptr;
     }
 
+    /*
+     * Cache of cuts and lemmas whose literals are all bound atoms.
+     * They are valid in the theory, so they are added again when their
+     * atoms are internalized after a pop deleted them.
+     * The last literal of a cut is the new bound, its atom only exists
+     * because of the cut. A cut is therefore added again when the atoms
+     * of its other literals are internalized, and the bound is internalized
+     * with it.
+     * The cache is bounded, lemmas beyond the bound are not cached.
+     */
+
+    expr_ref_vector                m_cached_lemmas;     // disjunctions of bound literals
+    bool_vector                    m_cached_is_cut;
+    obj_hashtable<expr>            m_cached_lemma_set;
+    obj_map<expr, unsigned_vector> m_atom2cached_lemmas;
+
+    void cache_lemma(literal_vector const& lits, bool is_cut = false) {
+        const unsigned max_cached_lemmas = 10000;
+        if (!params().m_arith_cache_lemmas || lits.size() <= (is_cut ? 1u : 0u) || m_cached_lemmas.size() >= max_cached_lemmas)
+            return;
+        expr_ref_vector disj(m);
+        for (literal lit : lits) {
+            if (!m_bool_var2bound.contains(lit.var()))
+                return;
+            disj.push_back(ctx().literal2expr(lit));
+        }
+        expr_ref lemma = ::mk_or(disj);
+        if (m_cached_lemma_set.contains(lemma))
+            return;
+        unsigned idx = m_cached_lemmas.size();
+        m_cached_lemmas.push_back(lemma);
+        m_cached_is_cut.push_back(is_cut);
+        m_cached_lemma_set.insert(lemma);
+        unsigned num_triggers = is_cut ? lits.size() - 1 : lits.size();
+        for (unsigned i = 0; i < num_triggers; ++i)
+            m_atom2cached_lemmas.insert_if_not_there(ctx().bool_var2expr(lits[i].var()), unsigned_vector()).push_back(idx);
+    }
+
+    void add_cached_lemmas(expr* atom) {
+        if (!params().m_arith_cache_lemmas)
+            return;
+        auto* e = m_atom2cached_lemmas.find_core(atom);
+        if (!e)
+            return;
+        literal_vector lits;
+        for (unsigned idx : e->get_data().m_value) {
+            expr* lemma = m_cached_lemmas.get(idx);
+            unsigned n = m.is_or(lemma) ? to_app(lemma)->get_num_args() : 1;
+            expr* const* args = m.is_or(lemma) ? to_app(lemma)->get_args() : &lemma;
+            lits.reset();
+            for (unsigned i = 0; i < n; ++i) {
+                expr* a = args[i];
+                bool sign = m.is_not(a, a);
+                if (!ctx().b_internalized(a)) {
+                    if (!m_cached_is_cut[idx] || i + 1 < n)
+                        break;
+                    ctx().internalize(a, true);
+                    ctx().mark_as_relevant(a);
+                }
+                lits.push_back(literal(ctx().get_bool_var(a), sign));
+            }
+            if (lits.size() < n)
+                continue;
+            TRACE("arith", tout << "re-adding cached lemma " << mk_pp(lemma, m) << "\n";);
+            ++m_stats.m_cached_lemmas;
+            ctx().mk_th_axiom(get_id(), lits.size(), lits.data());
+        }
+    }
+
 
     void validate_model(proto_model& mdl) {
 
@@ -60,6 +60,13 @@ public:
     */
     virtual solver* translate(ast_manager& m, params_ref const& p) = 0;
 
+    /**
+    \brief Creates an independent clone over the same manager.
+    Solvers that can reuse their search state (e.g., learned lemmas)
+    override this method, the default is translate.
+    */
+    virtual solver* fork(params_ref const& p) { return translate(get_manager(), p); }
+
     /**
        \brief Update the solver internal settings. 
     */
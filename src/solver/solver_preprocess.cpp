@@ -41,9 +41,13 @@ Notes:
 #include "ast/simplifiers/flatten_clauses.h"
 #include "ast/simplifiers/bound_simplifier.h"
 #include "ast/simplifiers/cnf_nnf.h"
+#include "ast/simplifiers/parallel_simplifier.h"
 #include "smt/params/smt_params.h"
 #include "solver/solver_preprocess.h"
 #include "qe/lite/qe_lite_tactic.h"
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 void init_preprocess(ast_manager& m, params_ref const& p, then_simplifier& s, dependent_expr_state& st) {
 
@@ -59,8 +63,21 @@ void init_preprocess(ast_manager& m, params_ref const& p, then_simplifier& s, de
         return r;
     };
     smt_params smtp(p);
-    s.add_simplifier(alloc(rewriter_simplifier, m, p, st));
-    if (smtp.m_propagate_values) s.add_simplifier(alloc(propagate_values, m, p, st));
+    unsigned num_threads = smtp.m_preprocess_threads;
+#ifndef SINGLE_THREAD
+    num_threads = std::min(num_threads, std::thread::hardware_concurrency());
+#endif
+    if (num_threads > 1) {
+        auto* ps = alloc(parallel_simplifier, m, p, st, num_threads);
+        ps->add_simplifier([](ast_manager& m, params_ref const& p, dependent_expr_state& s) -> dependent_expr_simplifier* { return alloc(rewriter_simplifier, m, p, s); });
+        if (smtp.m_propagate_values) 
+            ps->add_simplifier([](ast_manager& m, params_ref const& p, dependent_expr_state& s) -> dependent_expr_simplifier* { return alloc(propagate_values, m, p, s); });
+        s.add_simplifier(ps);
+    }
+    else {
+        s.add_simplifier(alloc(rewriter_simplifier, m, p, st));
+        if (smtp.m_propagate_values) s.add_simplifier(alloc(propagate_values, m, p, st));
+    }
     if (smtp.m_solve_eqs) s.add_simplifier(alloc(euf::solve_eqs, m, st));
     if (smtp.m_elim_unconstrained) s.add_simplifier(alloc(elim_unconstrained, m, st));
     if (smtp.m_nnf_cnf) s.add_simplifier(alloc(cnf_nnf_simplifier, m, p, st));
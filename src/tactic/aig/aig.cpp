@@ -1306,6 +1306,323 @@ struct aig_manager::imp {
         }
     };
 
+    /**
+       \brief SAT sweeping restricted to small cones.
+
+       Nodes are partitioned into candidate classes by random simulation.
+       A node is merged with an earlier node of its class (modulo
+       complement) if the two agree on every assignment to their joint
+       support. The check is exhaustive simulation, so only pairs whose
+       joint support has at most MAX_SUPPORT variables are compared.
+       The exhaustive checks of one sweep evaluate at most MAX_WORK
+       words; later nodes are kept as they are.
+    */
+    struct sweep_proc {
+        static const unsigned SIM_WORDS      = 4;
+        static const unsigned MAX_SUPPORT    = 12;
+        static const unsigned MAX_CANDIDATES = 8;
+        static const unsigned MAX_WORK       = 1u << 24;
+
+        imp &                   m;
+        ptr_vector<aig>         m_nodes;     // cone of the root in topological order
+        u_map<unsigned>         m_id2idx;
+        svector<uint64_t>       m_sim;       // SIM_WORDS random patterns per node
+        vector<unsigned_vector> m_support;   // sorted variable ids
+        bool_vector             m_big;       // support exceeds MAX_SUPPORT
+        bool_vector             m_phase;     // first simulation bit, used to normalize classes
+        unsigned_vector         m_repr;      // index of representative, or UINT_MAX
+        bool_vector             m_repr_sign;
+        u_map<unsigned>         m_class;     // signature -> last node of the class
+        unsigned_vector         m_next;      // next node of the same class
+        unsigned_vector         m_vars;
+        unsigned_vector         m_cone;
+        unsigned_vector         m_stamp;
+        unsigned                m_stamp_val = 0;
+        unsigned_vector         m_offset;
+        svector<uint64_t>       m_val;
+        svector<aig_lit>        m_new;
+        unsigned                m_num_merged = 0;
+        uint64_t                m_work = 0;
+
+        sweep_proc(imp & _m):m(_m) {}
+
+        unsigned idx(aig * n) const {
+            unsigned i = 0;
+            VERIFY(m_id2idx.find(n->m_id, i));
+            return i;
+        }
+
+        bool is_true(aig * n) const { return n == m.m_true.ptr(); }
+
+        void add(aig * n) {
+            n->m_mark = true;
+            m_id2idx.insert(n->m_id, m_nodes.size());
+            m_nodes.push_back(n);
+        }
+
+        void collect(aig * root) {
+            add(m.m_true.ptr());
+            ptr_vector<aig> todo;
+            todo.push_back(root);
+            while (!todo.empty()) {
+                aig * n = todo.back();
+                if (n->m_mark) {
+                    todo.pop_back();
+                    continue;
+                }
+                bool visited = true;
+                if (!is_var(n)) {
+                    for (unsigned i = 0; i < 2; i++) {
+                        aig * c = n->m_children[i].ptr();
+                        if (!c->m_mark) {
+                            todo.push_back(c);
+                            visited = false;
+                        }
+                    }
+                }
+                if (visited) {
+                    add(n);
+                    todo.pop_back();
+                }
+            }
+            unmark(m_nodes.size(), m_nodes.data());
+        }
+
+        uint64_t sim(aig_lit l, unsigned w) const {
+            uint64_t v = m_sim[idx(l.ptr()) * SIM_WORDS + w];
+            return l.is_inverted() ? ~v : v;
+        }
+
+        static uint64_t rand64(random_gen & r) {
+            uint64_t v = 0;
+            for (unsigned i = 0; i < 5; i++)
+                v = (v << 15) ^ static_cast<uint64_t>(r());
+            return v;
+        }
+
+        void simulate() {
+            random_gen r(0);
+            unsigned sz = m_nodes.size();
+            m_sim.resize(sz * SIM_WORDS);
+            m_support.resize(sz);
+            m_big.resize(sz, false);
+            m_phase.resize(sz, false);
+            for (unsigned i = 0; i < sz; i++) {
+                aig * n = m_nodes[i];
+                for (unsigned w = 0; w < SIM_WORDS; w++) {
+                    uint64_t v;
+                    if (is_true(n))
+                        v = ~static_cast<uint64_t>(0);
+                    else if (is_var(n))
+                        v = rand64(r);
+                    else
+                        v = sim(left(n), w) & sim(right(n), w);
+                    m_sim[i * SIM_WORDS + w] = v;
+                }
+                m_phase[i] = (m_sim[i * SIM_WORDS] & 1) != 0;
+                if (is_true(n))
+                    continue;
+                if (is_var(n)) {
+                    m_support[i].push_back(n->m_id);
+                    continue;
+                }
+                unsigned i1 = idx(left(n).ptr()), i2 = idx(right(n).ptr());
+                if (m_big[i1] || m_big[i2] || !merge(m_support[i1], m_support[i2], m_support[i]))
+                    m_big[i] = true;
+            }
+        }
+
+        static bool merge(unsigned_vector const & s1, unsigned_vector const & s2, unsigned_vector & r) {
+            r.reset();
+            unsigned i = 0, j = 0;
+            while (i < s1.size() || j < s2.size()) {
+                if (r.size() == MAX_SUPPORT)
+                    return false;
+                if (j == s2.size() || (i < s1.size() && s1[i] < s2[j]))
+                    r.push_back(s1[i++]);
+                else if (i == s1.size() || s2[j] < s1[i])
+                    r.push_back(s2[j++]);
+                else {
+                    r.push_back(s1[i++]);
+                    j++;
+                }
+            }
+            return true;
+        }
+
+        uint64_t normalized(unsigned i, unsigned w) const {
+            uint64_t v = m_sim[i * SIM_WORDS + w];
+            return m_phase[i] ? ~v : v;
+        }
+
+        unsigned signature(unsigned i) const {
+            unsigned h = 17;
+            for (unsigned w = 0; w < SIM_WORDS; w++) {
+                uint64_t v = normalized(i, w);
+                h = hash_u_u(h, static_cast<unsigned>(v) ^ static_cast<unsigned>(v >> 32));
+            }
+            return h;
+        }
+
+        bool same_class(unsigned i, unsigned j) const {
+            for (unsigned w = 0; w < SIM_WORDS; w++)
+                if (normalized(i, w) != normalized(j, w))
+                    return false;
+            return true;
+        }
+
+        uint64_t val(aig_lit l, unsigned w, unsigned num_words) const {
+            uint64_t v = m_val[m_offset[idx(l.ptr())] * num_words + w];
+            return l.is_inverted() ? ~v : v;
+        }
+
+        /**
+           \brief check that node i is equivalent to node j (or to its
+           complement if sign) on all assignments to m_vars.
+        */
+        bool prove(unsigned i, unsigned j, bool sign) {
+            static const uint64_t masks[6] = {
+                0xAAAAAAAAAAAAAAAAull, 0xCCCCCCCCCCCCCCCCull, 0xF0F0F0F0F0F0F0F0ull,
+                0xFF00FF00FF00FF00ull, 0xFFFF0000FFFF0000ull, 0xFFFFFFFF00000000ull
+            };
+            unsigned k = m_vars.size();
+            unsigned num_words = k <= 6 ? 1 : 1u << (k - 6);
+            m_stamp_val++;
+            m_cone.reset();
+            m_cone.push_back(i);
+            m_cone.push_back(j);
+            m_stamp[i] = m_stamp[j] = m_stamp_val;
+            for (unsigned qhead = 0; qhead < m_cone.size(); qhead++) {
+                aig * n = m_nodes[m_cone[qhead]];
+                if (is_var(n))
+                    continue;
+                for (unsigned c = 0; c < 2; c++) {
+                    unsigned ci = idx(n->m_children[c].ptr());
+                    if (m_stamp[ci] != m_stamp_val) {
+                        m_stamp[ci] = m_stamp_val;
+                        m_cone.push_back(ci);
+                    }
+                }
+            }
+            std::sort(m_cone.begin(), m_cone.end());
+            m_work += static_cast<uint64_t>(m_cone.size()) * num_words;
+            m_val.reset();
+            m_val.resize(m_cone.size() * num_words, 0);
+            for (unsigned c = 0; c < m_cone.size(); c++) {
+                unsigned ni = m_cone[c];
+                aig * n = m_nodes[ni];
+                m_offset[ni] = c;
+                uint64_t * out = m_val.data() + c * num_words;
+                if (is_true(n)) {
+                    for (unsigned w = 0; w < num_words; w++)
+                        out[w] = ~static_cast<uint64_t>(0);
+                }
+                else if (is_var(n)) {
+                    unsigned p = 0;
+                    while (m_vars[p] != n->m_id)
+                        p++;
+                    SASSERT(p < k);
+                    for (unsigned w = 0; w < num_words; w++) {
+                        if (p < 6)
+                            out[w] = masks[p];
+                        else
+                            out[w] = ((w >> (p - 6)) & 1) ? ~static_cast<uint64_t>(0) : 0;
+                    }
+                }
+                else {
+                    for (unsigned w = 0; w < num_words; w++)
+                        out[w] = val(left(n), w, num_words) & val(right(n), w, num_words);
+                }
+            }
+            aig_lit li(m_nodes[i]), lj(m_nodes[j]);
+            if (sign)
+                lj.invert();
+            for (unsigned w = 0; w < num_words; w++)
+                if (val(li, w, num_words) != val(lj, w, num_words))
+                    return false;
+            return true;
+        }
+
+        void sweep() {
+            unsigned sz = m_nodes.size();
+            m_repr.resize(sz, UINT_MAX);
+            m_repr_sign.resize(sz, false);
+            m_next.resize(sz, UINT_MAX);
+            m_stamp.resize(sz, 0);
+            m_offset.resize(sz, 0);
+            for (unsigned i = 0; i < sz; i++) {
+                if ((i & 0xff) == 0)
+                    m.checkpoint();
+                unsigned sig = signature(i);
+                unsigned head = UINT_MAX;
+                m_class.find(sig, head);
+                if (!is_var(m_nodes[i]) && !m_big[i] && m_work < MAX_WORK) {
+                    unsigned num_candidates = 0;
+                    for (unsigned j = head; j != UINT_MAX && num_candidates < MAX_CANDIDATES; j = m_next[j]) {
+                        if (m_big[j] || !same_class(i, j))
+                            continue;
+                        ++num_candidates;
+                        if (!merge(m_support[i], m_support[j], m_vars))
+                            continue;
+                        if (prove(i, j, m_phase[i] != m_phase[j])) {
+                            m_repr[i] = j;
+                            m_repr_sign[i] = m_phase[i] != m_phase[j];
+                            m_num_merged++;
+                            break;
+                        }
+                    }
+                }
+                if (m_repr[i] == UINT_MAX) {
+                    m_next[i] = head;
+                    m_class.insert(sig, i);
+                }
+            }
+        }
+
+        aig_lit new_lit(aig_lit l) const {
+            aig_lit r = m_new[idx(l.ptr())];
+            if (l.is_inverted())
+                r.invert();
+            return r;
+        }
+
+        aig_lit rebuild(aig_lit root) {
+            unsigned sz = m_nodes.size();
+            m_new.resize(sz, aig_lit::null);
+            for (unsigned i = 0; i < sz; i++) {
+                aig * n = m_nodes[i];
+                aig_lit r;
+                if (is_var(n))
+                    r = aig_lit(n);
+                else if (m_repr[i] != UINT_MAX) {
+                    r = m_new[m_repr[i]];
+                    if (m_repr_sign[i])
+                        r.invert();
+                }
+                else
+                    r = m.mk_and(new_lit(left(n)), new_lit(right(n)));
+                m.inc_ref(r);
+                m_new[i] = r;
+            }
+            aig_lit r = new_lit(root);
+            m.inc_ref(r);
+            for (aig_lit const & l : m_new)
+                m.dec_ref(l);
+            m.dec_ref_result(r);
+            return r;
+        }
+
+        aig_lit operator()(aig_lit root) {
+            collect(root.ptr());
+            simulate();
+            sweep();
+            IF_VERBOSE(10, verbose_stream() << "(aig-sweep :nodes " << m_nodes.size() << " :merged " << m_num_merged << ")\n");
+            if (m_num_merged == 0)
+                return root;
+            return rebuild(root);
+        }
+    };
+
 public:
     imp(ast_manager & m, unsigned long long max_memory, bool default_gate_encoding):
         m_var_id_gen(0),
@@ -1549,6 +1866,11 @@ public:
         return p(l);
     }
 
+    aig_lit sweep(aig_lit l) {
+        sweep_proc p(*this);
+        return p(l);
+    }
+
     void display_ref(std::ostream & out, aig * r) const {
         if (is_var(r)) 
             out << "#" << r->m_id;
@@ -1730,6 +2052,10 @@ void aig_manager::max_sharing(aig_ref & r) {
     r = aig_ref(*this, m_imp->max_sharing(aig_lit(r)));
 }
 
+void aig_manager::sweep(aig_ref & r) {
+    r = aig_ref(*this, m_imp->sweep(aig_lit(r)));
+}
+
 
 void aig_manager::to_formula(aig_ref const & r, expr_ref & res) {
     return m_imp->to_formula(aig_lit(r), res);
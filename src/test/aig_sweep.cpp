@@ -0,0 +1,152 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    aig_sweep.cpp
+
+Abstract:
+
+    Tests for sweeping of AIGs. The swept AIG must agree with its input
+    on every assignment, equivalent and complemented nodes must be
+    merged, and no nodes may be leaked.
+
+Author:
+
+    agent 2026-10-17
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "model/model.h"
+#include "tactic/aig/aig.h"
+#include <iostream>
+
+static const unsigned NUM_VARS = 6;
+static const unsigned POOL_SIZE = NUM_VARS + 30;
+
+// compare the formulas of r1 and r2 on all assignments to vars.
+static void check_equiv(ast_manager & m, aig_manager & am, expr_ref_vector const & vars, aig_ref const & r1, aig_ref const & r2) {
+    expr_ref f1(m), f2(m);
+    am.to_formula(r1, f1);
+    am.to_formula(r2, f2);
+    for (unsigned bits = 0; bits < (1u << vars.size()); ++bits) {
+        model mdl(m);
+        for (unsigned i = 0; i < vars.size(); ++i)
+            mdl.register_decl(to_app(vars.get(i))->get_decl(), (bits & (1u << i)) ? m.mk_true() : m.mk_false());
+        ENSURE(mdl.is_true(f1) == mdl.is_true(f2));
+        ENSURE(mdl.is_false(f1) == mdl.is_false(f2));
+    }
+}
+
+// xor(a, b) as (a and not b) or (not a and b).
+static aig_ref mk_xor1(aig_manager & am, aig_ref const & a, aig_ref const & b) {
+    return am.mk_or(am.mk_and(a, am.mk_not(b)), am.mk_and(am.mk_not(a), b));
+}
+
+// xor(a, b) as (a or b) and not (a and b).
+static aig_ref mk_xor2(aig_manager & am, aig_ref const & a, aig_ref const & b) {
+    return am.mk_and(am.mk_or(a, b), am.mk_not(am.mk_and(a, b)));
+}
+
+// not xor(a, b) as (a and b) or (not a and not b).
+static aig_ref mk_xnor(aig_manager & am, aig_ref const & a, aig_ref const & b) {
+    return am.mk_or(am.mk_and(a, b), am.mk_and(am.mk_not(a), am.mk_not(b)));
+}
+
+static void tst_sweep_merge(ast_manager & m, aig_manager & am, expr_ref_vector const & vars, aig_ref const * lits) {
+    aig_ref const & a = lits[0], & b = lits[1], & c = lits[2], & d = lits[3];
+    unsigned base = am.get_num_aigs();
+    {
+        // the second xor is equivalent to the first one.
+        aig_ref r = am.mk_and(am.mk_or(mk_xor1(am, a, b), c), am.mk_or(mk_xor2(am, a, b), d));
+        unsigned before = am.get_num_aigs();
+        aig_ref s;
+        s = r;
+        am.sweep(s);
+        check_equiv(m, am, vars, r, s);
+        r = aig_ref();
+        std::cout << "aig nodes before sweep " << before << " after " << am.get_num_aigs() << "\n";
+        ENSURE(am.get_num_aigs() < before);
+    }
+    ENSURE(am.get_num_aigs() == base);
+    {
+        // xnor is the complement of xor, so the conjunction is false.
+        aig_ref r = am.mk_and(am.mk_or(mk_xor1(am, a, b), c), am.mk_and(mk_xnor(am, a, b), am.mk_not(c)));
+        aig_ref s;
+        s = r;
+        am.sweep(s);
+        check_equiv(m, am, vars, r, s);
+        expr_ref f(m);
+        am.to_formula(s, f);
+        ENSURE(m.is_false(f));
+        // sweeping a constant leaves it unchanged.
+        am.sweep(s);
+        am.to_formula(s, f);
+        ENSURE(m.is_false(f));
+        s = am.mk_not(s);
+        am.sweep(s);
+        am.to_formula(s, f);
+        ENSURE(m.is_true(f));
+    }
+    ENSURE(am.get_num_aigs() == base);
+}
+
+static aig_ref mk_random(aig_manager & am, random_gen & r, aig_ref const * pool, unsigned sz) {
+    aig_ref const & x = pool[r(sz)];
+    aig_ref const & y = pool[r(sz)];
+    aig_ref const & z = pool[r(sz)];
+    switch (r(7)) {
+    case 0: return am.mk_and(x, y);
+    case 1: return am.mk_or(x, am.mk_not(y));
+    case 2: return am.mk_iff(x, y);
+    case 3: return am.mk_ite(x, y, z);
+    case 4: return mk_xor1(am, x, y);
+    case 5: return mk_xor2(am, x, y);
+    default: return mk_xnor(am, x, y);
+    }
+}
+
+static void tst_sweep_random(ast_manager & m, aig_manager & am, expr_ref_vector const & vars, aig_ref const * lits) {
+    unsigned base = am.get_num_aigs();
+    for (unsigned seed = 0; seed < 50; ++seed) {
+        random_gen r(seed);
+        // aig_ref is copied by assignment only.
+        aig_ref pool[POOL_SIZE];
+        for (unsigned i = 0; i < NUM_VARS; ++i)
+            pool[i] = lits[i];
+        for (unsigned i = NUM_VARS; i < POOL_SIZE; ++i)
+            pool[i] = mk_random(am, r, pool, i);
+        aig_ref root;
+        root = pool[POOL_SIZE - 1];
+        for (unsigned i = 0; i < 4; ++i) {
+            aig_ref const & x = pool[NUM_VARS + r(POOL_SIZE - NUM_VARS)];
+            root = r(2) ? am.mk_or(root, x) : am.mk_iff(root, x);
+        }
+        aig_ref s;
+        s = root;
+        am.sweep(s);
+        check_equiv(m, am, vars, root, s);
+        aig_ref t;
+        t = s;
+        am.sweep(t);
+        check_equiv(m, am, vars, root, t);
+    }
+    ENSURE(am.get_num_aigs() == base);
+}
+
+void tst_aig_sweep() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    expr_ref_vector vars(m);
+    {
+        aig_manager am(m);
+        aig_ref lits[NUM_VARS];
+        for (unsigned i = 0; i < NUM_VARS; ++i) {
+            vars.push_back(m.mk_const(symbol(("p" + std::to_string(i)).c_str()), m.mk_bool_sort()));
+            lits[i] = am.mk_aig(vars.get(i));
+        }
+        tst_sweep_merge(m, am, vars, lits);
+        tst_sweep_random(m, am, vars, lits);
+    }
+}
@@ -34,6 +34,30 @@ static char const* example1 = "(<= (+ (* 1.3 x y) (* 2.3 y y) (* (- 1.1 x x))) 2
 static char const* example2 = "(= (+ 4 3 (- (* 3 x x) (* 5 y)) y) 0)";
 
 
+static void tst_persistent_cache() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    params_ref p;
+    p.set_bool("persistent_cache", true);
+    expr_ref fml = parse_fml(m, example1);
+    expr_ref r1(m), r2(m);
+    {
+        th_rewriter rw(m, p);
+        rw(fml, r1);
+    }
+    ENSURE(m.get_rewrite_cache_size() > 0);
+    {
+        th_rewriter rw(m, p);
+        rw(fml, r2);
+        ENSURE(rw.get_num_steps() == 0);
+    }
+    ENSURE(r1 == r2);
+    fml = nullptr;
+    r1 = nullptr;
+    r2 = nullptr;
+    ENSURE(m.get_rewrite_cache_size() == 0);
+}
+
 void tst_arith_rewriter() {
     ast_manager m;
     reg_decl_plugins(m);
@@ -56,4 +80,6 @@ void tst_arith_rewriter() {
     fml = parse_fml(m, example2);
     rw(fml);
     std::cout << mk_pp(fml, m) << "\n";
+
+    tst_persistent_cache();
 }
@@ -5,6 +5,7 @@ Copyright (c) 2020 Microsoft Corporation
 
 #include "util/util.h"
 #include "util/timer.h"
+#include "util/statistics.h"
 #include "ast/euf/euf_egraph.h"
 #include "ast/reg_decl_plugins.h"
 #include "ast/ast_pp.h"
@@ -130,7 +131,53 @@ static void test3() {
         std::cout << "conflict: " << *j << "\n";
 }
 
+// congruence table micro benchmark: random binary and unary terms over
+// a pool of constants, merged and backtracked in rounds.
+static void test4() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    euf::egraph g(m);
+    sort_ref S(m.mk_uninterpreted_sort(symbol("S")), m);
+    sort* SS[2] = { S, S };
+    func_decl_ref f(m.mk_func_decl(symbol("f"), S, S), m);
+    func_decl_ref h(m.mk_func_decl(symbol("h"), 2, SS, S), m);
+    unsigned num_consts = 2000, num_terms = 40000, num_rounds = 50, num_merges = 400;
+    random_gen r(0);
+    expr_ref_vector pinned(m);
+    euf::enode_vector consts, nodes;
+    for (unsigned i = 0; i < num_consts; ++i) {
+        expr_ref x = mk_const(m, ("c" + std::to_string(i)).c_str(), S);
+        pinned.push_back(x);
+        consts.push_back(g.mk(x, 0, 0, nullptr));
+    }
+    nodes.append(consts);
+    for (unsigned i = 0; i < num_terms; ++i) {
+        euf::enode* args[2] = { nodes[r(nodes.size())], consts[r(num_consts)] };
+        expr* eargs[2] = { args[0]->get_expr(), args[1]->get_expr() };
+        bool unary = r(4) == 0;
+        expr_ref t(unary ? m.mk_app(f, eargs[0]) : m.mk_app(h, 2, eargs), m);
+        if (g.find(t))
+            continue;
+        pinned.push_back(t);
+        nodes.push_back(g.mk(t, 0, unary ? 1 : 2, args));
+    }
+    g.propagate();
+    timer t;
+    for (unsigned i = 0; i < num_rounds; ++i) {
+        g.push();
+        for (unsigned j = 0; j < num_merges && !g.inconsistent(); ++j)
+            g.merge(consts[r(num_consts)], consts[r(num_consts)], nullptr);
+        g.propagate();
+        g.pop(1);
+    }
+    statistics st;
+    g.collect_statistics(st);
+    st.display(std::cout);
+    std::cout << "nodes " << nodes.size() << " rounds " << num_rounds << " seconds " << t.get_seconds() << "\n";
+}
+
 void tst_egraph() {
+    test4();
     enable_trace("euf");
     test3();
     test1();
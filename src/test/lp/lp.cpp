@@ -469,6 +469,7 @@ bool contains(std::string const &s, char const *pattern) {
 
 void setup_args_parser(argument_parser &parser) {
     parser.add_option_with_help_string("-add_rows", "test add_rows of static matrix");
+    parser.add_option_with_help_string("-pivot_bench", "benchmark row pivots of static matrix");
     parser.add_option_with_help_string("-monics", "test emonics");
     parser.add_option_with_help_string("-nex_order", "test nex order");
     parser.add_option_with_help_string("-nla_cn", "test cross nornmal form");
@@ -1758,6 +1759,49 @@ void test_gomory_cut() {
         SASSERT(matrix.get_elem(1, 2) == 4); // unchanged
     }
     
+// Measures the throughput of tableau pivots on a random sparse matrix.
+void test_pivot_bench() {
+    unsigned m = 300, n = 600, row_nnz = 8, num_pivots = 200;
+    lp::static_matrix<mpq, impq> A;
+    A.init_empty_matrix(m, n);
+    for (unsigned i = 0; i < m; i++) {
+        A.set(i, i, mpq(1));
+        for (unsigned k = 0; k < row_nnz; k++) {
+            unsigned j = m + my_random() % (n - m);
+            if (A.get_elem(i, j).is_zero())
+                A.set(i, j, mpq(1 + my_random() % 7, 1 + my_random() % 3));
+        }
+    }
+    unsigned pivots = 0;
+    stopwatch sw;
+    sw.start();
+    for (unsigned p = 0; p < num_pivots; p++) {
+        unsigned r = my_random() % m;
+        auto & row = A.m_rows[r];
+        if (row.empty())
+            continue;
+        unsigned j = row[my_random() % row.size()].var();
+        mpq piv = A.get_elem(r, j);
+        for (auto & rc : row)
+            rc.coeff() /= piv;
+        auto & column = A.m_columns[j];
+        while (column.size() > 1) {
+            auto & c = column.back().var() != r ? column.back() : column[column.size() - 2];
+            A.pivot_row_to_row_given_cell(r, c, j);
+            pivots++;
+        }
+    }
+    sw.stop();
+    SASSERT(A.is_correct());
+    unsigned nnz = 0;
+    for (auto const & row : A.m_rows)
+        nnz += static_cast<unsigned>(row.size());
+    std::cout << "row pivots " << pivots << " in " << sw.get_seconds() << " secs, "
+              << (sw.get_seconds() > 0 ? pivots / sw.get_seconds() : 0) << " pivots/sec, "
+              << nnz << " non-zeros, column cell " << sizeof(lp::column_cell) << " bytes, "
+              << "row cell " << sizeof(lp::row_cell<mpq>) << " bytes" << std::endl;
+}
+
 void test_nla_order_lemma() { nla::test_order_lemma(); }
 
 void test_lp_local(int argn, char **argv) {
@@ -1778,6 +1822,10 @@ void test_lp_local(int argn, char **argv) {
         test_add_rows();
         return finalize(0);
     }
+    if (args_parser.option_is_used("-pivot_bench")) {
+        test_pivot_bench();
+        return finalize(0);
+    }
     if (args_parser.option_is_used("-monics")) {
         nla::test_monics();
         return finalize(0);
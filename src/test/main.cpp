@@ -172,6 +172,8 @@ int main(int argc, char ** argv) {
     TST(timeout);
     TST(proof_checker);
     TST(simplifier);
+    TST(parallel_simplifier);
+    TST(simplifier_solver);
     TST(bit_blaster);
     TST(var_subst);
     TST(simple_parser);
@@ -202,6 +204,7 @@ int main(int argc, char ** argv) {
     TST(nlarith_util);
     TST(api_bug);
     TST(arith_rewriter);
+    TST(aig_sweep);
     TST(check_assumptions);
     TST(smt_context);
     TST(theory_dl);
@@ -209,6 +212,8 @@ int main(int argc, char ** argv) {
     TST(model_based_opt);
     TST(factor_rewriter);
     TST(smt2print_parse);
+    TST(smt2_scanner);
+    TST(smt2_parallel_parse);
     TST(substitution);
     TST(polynomial);
     TST(upolynomial);
@@ -244,11 +249,15 @@ int main(int argc, char ** argv) {
     TST(rcf);
     TST(polynorm);
     TST(qe_arith);
+    TST(qi_profiler);
     TST(expr_substitution);
     TST(sorting_network);
     TST(theory_pb);
     TST(simplex);
     TST(sat_user_scope);
+    TST(sat_inprocess);
+    TST(sat_gc);
+    TST(sat_parallel);
     TST_ARGV(ddnf);
     TST(ddnf1);
     TST(model_evaluator);
@@ -256,6 +265,8 @@ int main(int argc, char ** argv) {
     TST(pb2bv);
     TST_ARGV(sat_lookahead);
     TST_ARGV(sat_local_search);
+    TST_ARGV(sat_propagate);
+    TST_ARGV(smt2_parse);
     TST_ARGV(cnf_backbones);
     TST(bdd);
     TST(pdd);
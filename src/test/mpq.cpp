@@ -160,7 +160,44 @@ static void tst_prev_power_2() {
     tst_prev_power_2((1ll << 60), 3, 58);
 }
 
+// compare the results of the small rational fast paths against mpz cross multiplication.
+static void tst_small_ops() {
+    unsynch_mpq_manager m;
+    scoped_mpq a(m), b(m), c(m);
+    scoped_mpz l(m), r(m), t(m);
+    int vals[] = { 0, 1, -1, 2, 3, -6, 7, 12, 1000003, -999983, INT_MAX, INT_MIN + 1, INT_MIN };
+    for (int an : vals) for (int ad : vals) for (int bn : vals) for (int bd : vals) {
+        if (ad <= 0 || bd <= 0)
+            continue;
+        m.set(a, an, ad);
+        m.set(b, bn, bd);
+        // c = a + b: num(c)*den(a)*den(b) = (num(a)*den(b) + num(b)*den(a))*den(c)
+        m.add(a, b, c);
+        m.mul(c.get().numerator(), a.get().denominator(), l);
+        m.mul(l, b.get().denominator(), l);
+        m.mul(a.get().numerator(), b.get().denominator(), r);
+        m.mul(b.get().numerator(), a.get().denominator(), t);
+        m.add(r, t, r);
+        m.mul(r, c.get().denominator(), r);
+        ENSURE(m.eq(l, r));
+        m.sub(c, b, c);
+        ENSURE(m.eq(a, c));
+        // c = a * b: num(c)*den(a)*den(b) = num(a)*num(b)*den(c)
+        m.mul(a, b, c);
+        m.mul(c.get().numerator(), a.get().denominator(), l);
+        m.mul(l, b.get().denominator(), l);
+        m.mul(a.get().numerator(), b.get().numerator(), r);
+        m.mul(r, c.get().denominator(), r);
+        ENSURE(m.eq(l, r));
+        // a < b iff num(a)*den(b) < num(b)*den(a)
+        m.mul(a.get().numerator(), b.get().denominator(), l);
+        m.mul(b.get().numerator(), a.get().denominator(), r);
+        ENSURE(m.lt(a, b) == m.lt(l, r));
+    }
+}
+
 void tst_mpq() {
+    tst_small_ops();
     tst_prev_power_2();
     set_str_bug();
     bug2();
@@ -504,6 +504,48 @@ static void tst_pw2() {
     }
 }
 
+// random number with num_digits 32-bit digits
+static void mk_rand_num(unsynch_mpz_manager & m, unsigned num_digits, mpz & r) {
+    scoped_mpz d(m);
+    m.set(r, 0);
+    for (unsigned i = 0; i < num_digits; i++) {
+        m.mul2k(r, 32);
+        m.set(d, static_cast<uint64_t>((rand() << 16) ^ rand()));
+        m.add(r, d, r);
+    }
+    m.add(r, mpz(1), r);
+}
+
+// exercise the sub-quadratic multiplication on operands above the schoolbook threshold.
+static void tst_big_mul() {
+    unsynch_mpz_manager m;
+    scoped_mpz a(m), b(m), c(m), q(m), r(m), t(m);
+    unsigned sizes[] = { 1, 7, 31, 32, 33, 64, 65, 100, 257, 600 };
+    for (unsigned sa : sizes) {
+        for (unsigned sb : sizes) {
+            mk_rand_num(m, sa, a);
+            mk_rand_num(m, sb, b);
+            m.mul(a, b, c);
+            m.div(c, b, q);
+            m.rem(c, b, r);
+            ENSURE(m.eq(q, a));
+            ENSURE(m.is_zero(r));
+            // (a + 1)*b - a*b = b
+            m.add(a, mpz(1), t);
+            m.mul(t, b, t);
+            m.sub(t, c, t);
+            ENSURE(m.eq(t, b));
+            // a*a = (a-1)*(a+1) + 1
+            m.mul(a, a, c);
+            m.sub(a, mpz(1), q);
+            m.add(a, mpz(1), r);
+            m.mul(q, r, t);
+            m.add(t, mpz(1), t);
+            ENSURE(m.eq(t, c));
+        }
+    }
+}
+
 void tst_mpz() {
     disable_trace("mpz");
     enable_trace("mpz_2k");
@@ -526,4 +568,5 @@ void tst_mpz() {
     tst1();
     tst2();
     tst2b();
+    tst_big_mul();
 }
@@ -0,0 +1,97 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    parallel_simplifier.cpp
+
+Abstract:
+
+    Test that parallel simplification of independent assertions
+    gives the same assertions as sequential simplification.
+
+Author:
+
+    agent 2026-10-17
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/simplifiers/parallel_simplifier.h"
+#include "ast/simplifiers/propagate_values.h"
+#include "ast/simplifiers/rewriter_simplifier.h"
+#include "util/statistics.h"
+#include <iostream>
+
+namespace {
+    class fml_state : public dependent_expr_state {
+        vector<dependent_expr> m_fmls;
+        bool                   m_updated = false;
+    public:
+        fml_state(ast_manager& m) : dependent_expr_state(m) {}
+        unsigned qtail() const override { return m_fmls.size(); }
+        dependent_expr const& operator[](unsigned i) override { return m_fmls[i]; }
+        void update(unsigned i, dependent_expr const& j) override { m_fmls[i] = j; m_updated = true; }
+        void add(dependent_expr const& j) override { m_fmls.push_back(j); m_updated = true; }
+        bool inconsistent() override { return false; }
+        model_reconstruction_trail& model_trail() override { throw default_exception("unexpected access to model reconstruction"); }
+        bool updated() override { return m_updated; }
+        void reset_updated() override { m_updated = false; }
+    };
+}
+
+static dependent_expr_simplifier* mk_rewriter(ast_manager& m, params_ref const& p, dependent_expr_state& s) {
+    return alloc(rewriter_simplifier, m, p, s);
+}
+
+static dependent_expr_simplifier* mk_propagate_values(ast_manager& m, params_ref const& p, dependent_expr_state& s) {
+    return alloc(propagate_values, m, p, s);
+}
+
+void tst_parallel_simplifier() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    expr_ref_vector fmls(m);
+    // groups of assertions over x_i, y_i and z_i. All groups share values
+    // and the interpreted ground term 1 + 2, which must not connect them.
+    unsigned num_groups = 20;
+    expr_ref three(a.mk_add(a.mk_int(1), a.mk_int(2)), m);
+    for (unsigned i = 0; i < num_groups; ++i) {
+        std::string suffix = std::to_string(i);
+        expr_ref x(m.mk_const(symbol(("x" + suffix).c_str()), a.mk_int()), m);
+        expr_ref y(m.mk_const(symbol(("y" + suffix).c_str()), a.mk_int()), m);
+        expr_ref z(m.mk_const(symbol(("z" + suffix).c_str()), a.mk_int()), m);
+        fmls.push_back(m.mk_eq(y, three));
+        fmls.push_back(a.mk_gt(a.mk_add(x, y, a.mk_int(0)), a.mk_int(i)));
+        fmls.push_back(m.mk_eq(z, a.mk_mul(y, a.mk_add(x, a.mk_int(1)))));
+    }
+
+    params_ref p;
+    fml_state seq_st(m), par_st(m);
+    for (expr* f : fmls) {
+        seq_st.add(dependent_expr(m, f, nullptr, nullptr));
+        par_st.add(dependent_expr(m, f, nullptr, nullptr));
+    }
+    then_simplifier seq(m, p, seq_st);
+    seq.add_simplifier(mk_rewriter(m, p, seq_st));
+    seq.add_simplifier(mk_propagate_values(m, p, seq_st));
+    parallel_simplifier par(m, p, par_st, 4);
+    par.add_simplifier(mk_rewriter);
+    par.add_simplifier(mk_propagate_values);
+    seq.reduce();
+    par.reduce();
+
+    ENSURE(seq_st.qtail() == par_st.qtail());
+    for (unsigned i = 0; i < seq_st.qtail(); ++i)
+        ENSURE(seq_st[i].fml() == par_st[i].fml());
+
+    statistics st;
+    par.collect_statistics(st);
+    double components = st.get_value("parallel-simplifier-components");
+    std::cout << "components " << components << " rounds " << st.get_value("parallel-simplifier-rounds") << "\n";
+#ifndef SINGLE_THREAD
+    ENSURE(components == num_groups);
+#endif
+}
@@ -0,0 +1,68 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    qi_profiler.cpp
+
+Abstract:
+
+    Test for the JSON report of the quantifier instantiation profiler.
+
+Author:
+
+    agent 2026-10-17
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include "smt/smt_context.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+void tst_qi_profiler() {
+    // the instance of q1 creates h(g(a)), which q2 matches with the binding g(a).
+    // The instance of q2 contradicts the instance of q1.
+    char const* input =
+        "(declare-fun f (Int) Int)\n"
+        "(declare-fun g (Int) Int)\n"
+        "(declare-fun h (Int) Int)\n"
+        "(declare-fun P (Int) Bool)\n"
+        "(declare-const a Int)\n"
+        "(assert (P (f a)))\n"
+        "(assert (forall ((x Int)) (! (and (P (h (g x))) (P (g x))) :pattern ((f x)) :qid q1)))\n"
+        "(assert (forall ((y Int)) (! (not (P y)) :pattern ((h y)) :qid q2)))\n";
+
+    ast_manager m;
+    reg_decl_plugins(m);
+    cmd_context cmd(false, &m);
+    std::istringstream is(input);
+    VERIFY(parse_smt2_commands(cmd, is));
+
+    char const* file_name = "qi_profiler_test.json";
+    smt_params fp;
+    fp.m_mbqi = false;
+    fp.m_qi_profile_file = file_name;
+    smt::context ctx(m, fp);
+    for (expr* e : cmd.assertions())
+        ctx.assert_expr(e);
+    ENSURE(ctx.check() == l_false);
+
+    std::ifstream in(file_name);
+    ENSURE(!in.fail());
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    std::string report = buffer.str();
+    in.close();
+    std::remove(file_name);
+
+    ENSURE(report.find("\"quantifiers\"") != std::string::npos);
+    ENSURE(report.find("{\"qid\": \"q1\"") != std::string::npos);
+    ENSURE(report.find("{\"qid\": \"q2\", \"pattern\": \"((h (:var 0)))\", \"matches\": 1}") != std::string::npos);
+    ENSURE(report.find("{\"symbol\": \"h\"") != std::string::npos);
+    ENSURE(report.find("{\"from\": \"q1\", \"to\": \"q2\", \"count\": 1}") != std::string::npos);
+    ENSURE(report.find("{\"from\": \"q2\"") == std::string::npos);
+}
@@ -0,0 +1,130 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_gc.cpp
+
+Abstract:
+
+    Tests for the tiered garbage collection of learned clauses.
+
+Author:
+
+    agent 2026-10-17
+
+--*/
+
+#include "sat/sat_solver.h"
+#include "sat/sat_clause.h"
+#include <iostream>
+
+namespace sat {
+
+    class gc_test {
+        solver& s;
+    public:
+        gc_test(solver& s): s(s) {}
+
+        void gc() { s.gc_tiered(); }
+
+        unsigned count(ptr_vector<clause> const& cls) const {
+            unsigned n = 0;
+            for (clause* c : cls)
+                n += s.m_learned.contains(c);
+            return n;
+        }
+    };
+}
+
+static sat::clause* mk_learned(sat::solver& s, unsigned i, unsigned glue) {
+    sat::literal_vector lits;
+    for (unsigned j = 0; j < 4; ++j)
+        lits.push_back(sat::literal(4 * i + j, false));
+    sat::clause* c = s.mk_clause(lits, sat::status::redundant());
+    ENSURE(c && c->is_learned());
+    c->set_glue(glue);
+    return c;
+}
+
+// core clauses survive every round. Idle tier-2 clauses are demoted after
+// gc.tier2_rounds + 1 rounds; then half of them are deleted as local clauses.
+static void tst_tiers(unsigned tier2_rounds, unsigned expected_rounds) {
+    params_ref p;
+    p.set_sym("gc", symbol("tiered"));
+    p.set_uint("gc.tier1_glue", 2);
+    p.set_uint("gc.tier2_glue", 6);
+    p.set_uint("gc.tier2_rounds", tier2_rounds);
+    reslimit limit;
+    sat::solver s(p, limit);
+    for (unsigned i = 0; i < 4 * 8; ++i)
+        s.mk_var();
+    ptr_vector<sat::clause> core, idle, used;
+    for (unsigned i = 0; i < 3; ++i)
+        core.push_back(mk_learned(s, i, 2));
+    for (unsigned i = 3; i < 7; ++i)
+        idle.push_back(mk_learned(s, i, 4));
+    used.push_back(mk_learned(s, 7, 4));
+
+    sat::gc_test t(s);
+    for (unsigned round = 1; round < expected_rounds; ++round) {
+        used[0]->mark_used();
+        t.gc();
+        ENSURE(t.count(idle) == idle.size());
+    }
+    used[0]->mark_used();
+    t.gc();
+    std::cout << "tier2_rounds " << tier2_rounds << " idle clauses after " << expected_rounds << " rounds " << t.count(idle) << "\n";
+    ENSURE(t.count(core) == core.size());
+    ENSURE(t.count(used) == used.size());
+    ENSURE(t.count(idle) == idle.size() / 2);
+}
+
+// solving with tiered gc gives the same results as the default gc.
+static void tst_solve() {
+    for (unsigned seed = 0; seed < 10; ++seed) {
+        lbool r[2];
+        for (unsigned k = 0; k < 2; ++k) {
+            params_ref p;
+            p.set_uint("gc.initial", 100);
+            p.set_uint("gc.increment", 100);
+            if (k == 1)
+                p.set_sym("gc", symbol("tiered"));
+            reslimit limit;
+            sat::solver s(p, limit);
+            random_gen rand(seed);
+            unsigned num_vars = 120;
+            for (unsigned i = 0; i < num_vars; ++i)
+                s.mk_var();
+            vector<sat::literal_vector> cnf;
+            for (unsigned i = 0; i < (num_vars * 43) / 10; ++i) {
+                sat::literal_vector lits;
+                while (lits.size() < 3) {
+                    sat::literal lit(rand(num_vars), rand(2) == 0);
+                    if (!lits.contains(lit) && !lits.contains(~lit))
+                        lits.push_back(lit);
+                }
+                s.mk_clause(lits);
+                cnf.push_back(lits);
+            }
+            r[k] = s.check();
+            if (r[k] == l_true) {
+                for (auto const& c : cnf) {
+                    bool sat = false;
+                    for (sat::literal lit : c)
+                        sat |= value_at(lit, s.get_model()) == l_true;
+                    ENSURE(sat);
+                }
+            }
+        }
+        ENSURE(r[0] != l_undef);
+        ENSURE(r[0] == r[1]);
+    }
+}
+
+void tst_sat_gc() {
+    tst_tiers(2, 3);
+    // the number of idle rounds is stored in 8 bits.
+    tst_tiers(255, 255);
+    tst_solve();
+}
@@ -0,0 +1,119 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_inprocess.cpp
+
+Abstract:
+
+    Tests for scheduled inprocessing in the SAT solver.
+    Each technique runs alone on small CNFs. The result must agree
+    with a solver without inprocessing and the reconstructed model
+    must satisfy the original clauses.
+
+Author:
+
+    agent 2026-10-17
+
+--*/
+
+#include "sat/sat_solver.h"
+#include "util/statistics.h"
+#include <iostream>
+
+typedef vector<sat::literal_vector> cnf_t;
+
+static void add_random_clauses(random_gen& r, unsigned num_vars, unsigned num_clauses, cnf_t& cnf) {
+    sat::literal_vector lits;
+    for (unsigned i = 0; i < num_clauses; ++i) {
+        lits.reset();
+        while (lits.size() < 3) {
+            sat::literal lit(r(num_vars), r(2) == 0);
+            if (!lits.contains(lit) && !lits.contains(~lit))
+                lits.push_back(lit);
+        }
+        cnf.push_back(lits);
+    }
+}
+
+// clauses (a_i or b_j or c) for all i, j. BVA replaces them by
+// clauses (a_i or x) and (~x or b_j or c).
+static void add_product_clauses(random_gen& r, unsigned num_vars, cnf_t& cnf) {
+    sat::literal_vector as, bs;
+    sat::literal c(num_vars - 1, false);
+    for (unsigned i = 0; i < 5; ++i) {
+        as.push_back(sat::literal(2 * i, r(2) == 0));
+        bs.push_back(sat::literal(2 * i + 1, r(2) == 0));
+    }
+    for (sat::literal a : as) {
+        for (sat::literal b : bs) {
+            cnf.push_back(sat::literal_vector());
+            cnf.back().push_back(a);
+            cnf.back().push_back(b);
+            cnf.back().push_back(c);
+        }
+    }
+}
+
+static lbool check(params_ref const& p, unsigned num_vars, cnf_t const& cnf, statistics& st) {
+    reslimit limit;
+    sat::solver s(p, limit);
+    for (unsigned i = 0; i < num_vars; ++i)
+        s.mk_var();
+    for (auto const& c : cnf)
+        s.mk_clause(c.size(), c.data());
+    lbool r = s.check();
+    if (r == l_true) {
+        sat::model const& m = s.get_model();
+        for (auto const& c : cnf) {
+            bool sat = false;
+            for (sat::literal lit : c)
+                sat |= value_at(lit, m) == l_true;
+            ENSURE(sat);
+        }
+    }
+    s.collect_statistics(st);
+    return r;
+}
+
+static void tst_technique(char const* effort, char const* yield, unsigned min_vars) {
+    params_ref base;
+    base.set_uint("max_conflicts", 100000);
+    params_ref p(base);
+    p.set_bool("inprocess.schedule", true);
+    p.set_uint("inprocess.vivify_effort", 0);
+    p.set_uint("inprocess.bva_effort", 0);
+    p.set_uint("inprocess.bve_effort", 0);
+    p.set_uint(effort, 1000);
+    p.set_uint("next_simplify", 100);
+    p.set_uint("simplify.delay", 0);
+    p.set_bool("enable_pre_simplify", true);
+
+    double total_yield = 0, num_sat = 0, num_unsat = 0;
+    for (unsigned seed = 0; seed < 20; ++seed) {
+        random_gen r(seed);
+        unsigned num_vars = min_vars + seed;
+        cnf_t cnf;
+        if (seed % 2 == 0)
+            add_product_clauses(r, num_vars, cnf);
+        add_random_clauses(r, num_vars, (num_vars * 43) / 10, cnf);
+        statistics st1, st2;
+        lbool r1 = check(base, num_vars, cnf, st1);
+        lbool r2 = check(p, num_vars, cnf, st2);
+        ENSURE(r1 != l_undef);
+        ENSURE(r1 == r2);
+        ENSURE(st2.get_value("sat inprocess rounds") > 0);
+        total_yield += st2.get_value(yield);
+        (r1 == l_true ? num_sat : num_unsat) += 1;
+    }
+    std::cout << effort << " sat " << num_sat << " unsat " << num_unsat << " " << yield << " " << total_yield << "\n";
+    ENSURE(total_yield > 0);
+}
+
+void tst_sat_inprocess() {
+    tst_technique("inprocess.bve_effort", "sat inprocess bve vars", 60);
+    tst_technique("inprocess.bva_effort", "sat inprocess bva vars", 60);
+    // vivification needs learned clauses, so it runs on larger instances.
+    tst_technique("inprocess.vivify_effort", "sat inprocess vivified literals", 150);
+}
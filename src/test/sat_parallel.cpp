@@ -0,0 +1,188 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_parallel.cpp
+
+Abstract:
+
+    Tests for clause sharing between parallel SAT solvers.
+
+Author:
+
+    agent 2026-10-17
+
+--*/
+
+#include "sat/sat_parallel.h"
+#include "sat/sat_solver.h"
+#include "sat/sat_clause.h"
+#include <iostream>
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
+
+// the clause stored at position pos.
+static void mk_ring_clause(uint64_t pos, sat::literal_vector& lits) {
+    lits.reset();
+    unsigned n = 2 + static_cast<unsigned>(pos % 5);
+    for (unsigned i = 0; i < n; ++i)
+        lits.push_back(sat::literal(static_cast<unsigned>((pos * 7 + i) % 1000), (pos + i) % 2 == 0));
+}
+
+static void tst_ring() {
+    // slots hold 4 literals, longer clauses are stored outside the slots.
+    sat::clause_ring ring(4, 4);
+    sat::literal_vector lits, expected;
+    for (uint64_t pos = 0; pos < 3; ++pos) {
+        mk_ring_clause(pos, lits);
+        ring.push(lits.size(), lits.data());
+    }
+    ENSURE(ring.tail() == 3);
+    for (uint64_t pos = 0; pos < 3; ++pos) {
+        ENSURE(ring.get(pos, lits));
+        mk_ring_clause(pos, expected);
+        ENSURE(lits == expected);
+    }
+    ENSURE(!ring.get(3, lits));
+    for (uint64_t pos = 3; pos < 10; ++pos) {
+        mk_ring_clause(pos, lits);
+        ring.push(lits.size(), lits.data());
+    }
+    // positions 0 to 5 were overwritten.
+    for (uint64_t pos = 0; pos < 10; ++pos) {
+        ENSURE(ring.get(pos, lits) == (pos >= 6));
+        if (pos >= 6) {
+            mk_ring_clause(pos, expected);
+            ENSURE(lits == expected);
+        }
+    }
+}
+
+// a consumer reads the ring while the producer overwrites it.
+// Every clause that is read must be the one stored at its position.
+static void tst_ring_concurrent() {
+#ifndef SINGLE_THREAD
+    sat::clause_ring ring(8, 4);
+    uint64_t num_clauses = 200000;
+    std::thread producer([&]() {
+        sat::literal_vector lits;
+        for (uint64_t pos = 0; pos < num_clauses; ++pos) {
+            mk_ring_clause(pos, lits);
+            ring.push(lits.size(), lits.data());
+        }
+    });
+    sat::literal_vector lits, expected;
+    uint64_t head = 0, num_read = 0, num_missed = 0;
+    while (head < num_clauses) {
+        uint64_t tail = ring.tail();
+        for (; head < tail; ++head) {
+            if (!ring.get(head, lits)) {
+                ++num_missed;
+                continue;
+            }
+            mk_ring_clause(head, expected);
+            ENSURE(lits == expected);
+            ++num_read;
+        }
+    }
+    producer.join();
+    std::cout << "ring read " << num_read << " missed " << num_missed << "\n";
+    ENSURE(num_read + num_missed == num_clauses);
+#endif
+}
+
+// duplicates are shared once, and long clauses with glue 2 are shared.
+static void tst_share() {
+    params_ref p;
+    p.set_uint("threads", 2);
+    p.set_uint("par.max_size", 4);
+    reslimit l0, l1;
+    sat::solver s0(p, l0), s1(p, l1);
+    for (unsigned i = 0; i < 10; ++i) {
+        s0.mk_var();
+        s1.mk_var();
+    }
+    sat::literal a(0, false), b(1, true);
+    sat::literal_vector long_lits;
+    for (unsigned i = 2; i < 8; ++i)
+        long_lits.push_back(sat::literal(i, false));
+    sat::clause* c1 = s0.mk_clause(long_lits, sat::status::redundant());
+    long_lits.back().neg();
+    sat::clause* c2 = s0.mk_clause(long_lits, sat::status::redundant());
+    c1->set_glue(2);
+    c2->set_glue(5);
+
+    sat::parallel par(s0);
+    par.reserve(2, 16);
+    s0.set_par(&par, 0);
+    s1.set_par(&par, 1);
+    par.share_clause(s0, a, b);
+    par.share_clause(s0, b, a);
+    par.share_clause(s0, *c1);
+    // longer than par.max_size and glue above 2.
+    par.share_clause(s0, *c2);
+    ENSURE(s0.get_stats().m_par_exported == 2);
+    ENSURE(par.has_clauses(s1));
+    ENSURE(!par.has_clauses(s0));
+
+    par.get_clauses(s1);
+    ENSURE(s1.get_stats().m_par_imported == 2);
+    ENSURE(!par.has_clauses(s1));
+    // s1 imported the clause, so it does not export it again.
+    par.share_clause(s1, b, a);
+    ENSURE(s1.get_stats().m_par_exported == 0);
+    ENSURE(!par.has_clauses(s0));
+    s0.set_par(nullptr, 0);
+    s1.set_par(nullptr, 0);
+}
+
+// parallel solving with forced imports gives the same results as one thread.
+static void tst_threads() {
+    for (unsigned seed = 0; seed < 10; ++seed) {
+        lbool r[2];
+        for (unsigned k = 0; k < 2; ++k) {
+            params_ref p;
+            if (k == 1) {
+                p.set_uint("threads", 4);
+                p.set_uint("par.import_interval", 50);
+            }
+            reslimit limit;
+            sat::solver s(p, limit);
+            random_gen rand(seed);
+            unsigned num_vars = 150;
+            for (unsigned i = 0; i < num_vars; ++i)
+                s.mk_var();
+            vector<sat::literal_vector> cnf;
+            for (unsigned i = 0; i < (num_vars * 426) / 100; ++i) {
+                sat::literal_vector lits;
+                while (lits.size() < 3) {
+                    sat::literal lit(rand(num_vars), rand(2) == 0);
+                    if (!lits.contains(lit) && !lits.contains(~lit))
+                        lits.push_back(lit);
+                }
+                s.mk_clause(lits);
+                cnf.push_back(lits);
+            }
+            r[k] = s.check();
+            if (r[k] == l_true) {
+                for (auto const& c : cnf) {
+                    bool sat = false;
+                    for (sat::literal lit : c)
+                        sat |= value_at(lit, s.get_model()) == l_true;
+                    ENSURE(sat);
+                }
+            }
+        }
+        ENSURE(r[0] != l_undef);
+        ENSURE(r[0] == r[1]);
+    }
+}
+
+void tst_sat_parallel() {
+    tst_ring();
+    tst_ring_concurrent();
+    tst_share();
+    tst_threads();
+}
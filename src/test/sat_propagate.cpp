@@ -0,0 +1,90 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_propagate.cpp
+
+Abstract:
+
+    Measure propagations per second of the SAT solver.
+
+    test-z3 sat_propagate [file.cnf] [sat.<param>=<value> ...]
+
+    Without a file name a random 3-CNF near the phase transition is used.
+    Search stops after sat.max_conflicts conflicts (default 100000).
+
+Author:
+
+    agent 2026-10-17
+
+--*/
+
+#include "sat/sat_solver.h"
+#include "sat/dimacs.h"
+#include "util/gparams.h"
+#include "util/statistics.h"
+#include "util/stopwatch.h"
+#include <fstream>
+#include <iostream>
+
+static void mk_random_3cnf(sat::solver& s, unsigned num_vars, unsigned num_clauses, vector<sat::literal_vector>& cls) {
+    random_gen r(0);
+    for (unsigned i = 0; i < num_vars; ++i)
+        s.mk_var();
+    sat::literal_vector lits;
+    for (unsigned i = 0; i < num_clauses; ++i) {
+        lits.reset();
+        while (lits.size() < 3) {
+            sat::literal lit(r(num_vars), r(2) == 0);
+            if (!lits.contains(lit) && !lits.contains(~lit))
+                lits.push_back(lit);
+        }
+        s.mk_clause(lits.size(), lits.data());
+        cls.push_back(lits);
+    }
+}
+
+void tst_sat_propagate(char ** argv, int argc, int& i) {
+    params_ref p = gparams::get_module("sat");
+    if (p.get_uint("max_conflicts", UINT_MAX) == UINT_MAX)
+        p.set_uint("max_conflicts", 100000);
+    reslimit limit;
+    sat::solver solver(p, limit);
+    vector<sat::literal_vector> cls;
+    if (i + 1 < argc && !strchr(argv[i + 1], '=')) {
+        char const* file_name = argv[i + 1];
+        ++i;
+        std::ifstream in(file_name);
+        if (in.bad() || in.fail()) {
+            std::cerr << "(error \"failed to open file '" << file_name << "'\")" << std::endl;
+            return;
+        }
+        if (!parse_dimacs(in, std::cerr, solver))
+            return;
+    }
+    else
+        mk_random_3cnf(solver, 20000, 84000, cls);
+
+    stopwatch sw;
+    sw.start();
+    lbool r = solver.check();
+    sw.stop();
+
+    statistics st;
+    solver.collect_statistics(st);
+    double props = st.get_value("sat propagations 2ary") + st.get_value("sat propagations nary");
+    double secs = sw.get_seconds();
+    std::cout << "result " << r << " conflicts " << st.get_value("sat conflicts")
+              << " propagations " << props << " secs " << secs
+              << " propagations/sec " << (secs > 0 ? props / secs : 0) << "\n";
+    if (r == l_true) {
+        sat::model const& m = solver.get_model();
+        for (auto const& c : cls) {
+            bool sat = false;
+            for (sat::literal lit : c)
+                sat |= value_at(lit, m) == l_true;
+            ENSURE(sat);
+        }
+    }
+}
@@ -0,0 +1,99 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    simplifier_solver.cpp
+
+Abstract:
+
+    Tests for incremental use of simplifier_solver. Models after pop
+    must be reconstructed from the current trail, not from converters
+    or unit propagations of popped scopes.
+
+Author:
+
+    agent 2026-10-17
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/simplifiers/then_simplifier.h"
+#include "ast/simplifiers/solve_eqs.h"
+#include "ast/simplifiers/propagate_values.h"
+#include "model/model.h"
+#include "smt/smt_solver.h"
+#include "solver/solver.h"
+#include "solver/simplifier_solver.h"
+
+// every formula in fmls is true in the model of s.
+static void check_model(solver & s, expr_ref_vector const & fmls) {
+    model_ref mdl;
+    s.get_model(mdl);
+    ENSURE(mdl);
+    for (expr * f : fmls)
+        ENSURE(mdl->is_true(f));
+}
+
+static void tst_push_pop() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    simplifier_factory fac = [](ast_manager& m, const params_ref& p, dependent_expr_state& st) {
+        scoped_ptr<then_simplifier> s = alloc(then_simplifier, m, p, st);
+        s->add_simplifier(alloc(euf::solve_eqs, m, st));
+        s->add_simplifier(alloc(propagate_values, m, p, st));
+        return s.detach();
+    };
+    ref<solver> s = mk_simplifier_solver(mk_smt_solver(m, params_ref(), symbol::null), &fac);
+    expr_ref x(m.mk_const("x", a.mk_int()), m), y(m.mk_const("y", a.mk_int()), m), z(m.mk_const("z", a.mk_int()), m);
+    expr_ref p(m.mk_const("p", m.mk_bool_sort()), m), q(m.mk_const("q", m.mk_bool_sort()), m), r(m.mk_const("r", m.mk_bool_sort()), m);
+    // solve-eqs eliminates x in the prefix.
+    expr_ref_vector fmls(m);
+    fmls.push_back(m.mk_eq(x, a.mk_add(y, a.mk_int(1))));
+    fmls.push_back(a.mk_ge(y, a.mk_int(0)));
+    fmls.push_back(p);
+    for (expr * f : fmls)
+        s->assert_expr(f);
+    ENSURE(s->check_sat() == l_true);
+    check_model(*s, fmls);
+
+    for (unsigned round = 0; round < 3; ++round) {
+        // z is eliminated in the scope, with a definition that differs in each round.
+        // The unit p of the prefix simplifies the clause to q or to r.
+        s->push();
+        expr_ref_vector scope(m);
+        scope.push_back(m.mk_eq(z, a.mk_add(x, a.mk_int(2 + round))));
+        scope.push_back(a.mk_le(y, a.mk_int(5 + round)));
+        scope.push_back(a.mk_ge(y, a.mk_int(5 + round)));
+        scope.push_back(m.mk_or(m.mk_not(p), round % 2 == 0 ? q : r));
+        for (expr * f : scope)
+            s->assert_expr(f);
+        ENSURE(s->check_sat() == l_true);
+        expr_ref_vector all(fmls);
+        all.append(scope);
+        check_model(*s, all);
+        // the cached converter is reused when nothing changed.
+        ENSURE(s->check_sat() == l_true);
+        check_model(*s, all);
+        s->pop(1);
+
+        // after pop, the eliminated z and the unit q or r no longer constrain the model.
+        expr_ref_vector after(fmls);
+        after.push_back(m.mk_eq(z, a.mk_mul(a.mk_int(2), x)));
+        after.push_back(m.mk_not(round % 2 == 0 ? q : r));
+        s->push();
+        for (unsigned i = fmls.size(); i < after.size(); ++i)
+            s->assert_expr(after.get(i));
+        ENSURE(s->check_sat() == l_true);
+        check_model(*s, after);
+        s->pop(1);
+        ENSURE(s->check_sat() == l_true);
+        check_model(*s, fmls);
+    }
+}
+
+void tst_simplifier_solver() {
+    tst_push_pop();
+}
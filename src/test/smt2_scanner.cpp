@@ -0,0 +1,221 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    smt2_scanner.cpp
+
+Abstract:
+
+    Tests for the SMT-LIB2 scanner and the parallel parser, and a
+    benchmark for the throughput of the scanner and the parser.
+
+    test-z3 smt2_parse [file.smt2] [threads]
+
+    Without a file name a synthetic benchmark is used.
+
+Author:
+
+    agent 2026-10-17
+
+--*/
+
+#include "parsers/smt2/smt2scanner.h"
+#include "parsers/smt2/smt2parser.h"
+#include "util/stopwatch.h"
+#include "ast/reg_decl_plugins.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+static void scan_all(std::string const& input, vector<smt2::scanner::token>& tokens, vector<std::string>& ids, vector<rational>& numbers) {
+    cmd_context ctx;
+    std::istringstream in(input);
+    smt2::scanner s(ctx, in);
+    while (true) {
+        auto t = s.scan();
+        tokens.push_back(t);
+        if (t == smt2::scanner::SYMBOL_TOKEN || t == smt2::scanner::KEYWORD_TOKEN)
+            ids.push_back(s.get_id().str());
+        if (t == smt2::scanner::INT_TOKEN || t == smt2::scanner::FLOAT_TOKEN)
+            numbers.push_back(s.get_number());
+        if (t == smt2::scanner::EOF_TOKEN)
+            break;
+    }
+}
+
+void tst_smt2_scanner() {
+    vector<smt2::scanner::token> tokens;
+    vector<std::string> ids;
+    vector<rational> numbers;
+
+    scan_all("(assert (<= x 123456789012345678901234567890 1.25 0.000000000000000000001)) ; comment\n \t foo", tokens, ids, numbers);
+    ENSURE(tokens.size() == 12);
+    ENSURE(tokens[0] == smt2::scanner::LEFT_PAREN);
+    ENSURE(ids.size() == 4 && ids[0] == "assert" && ids[1] == "<=" && ids[2] == "x" && ids[3] == "foo");
+    ENSURE(numbers.size() == 3);
+    ENSURE(numbers[0] == rational("123456789012345678901234567890"));
+    ENSURE(numbers[1] == rational(5, 4));
+    ENSURE(numbers[2] == rational(1) / power(rational(10), 21));
+
+    // tokens and comments that cross the boundaries of the input buffer.
+    std::string sym(40000, 'a');
+    std::string comment(40000, 'c');
+    std::ostringstream strm;
+    for (unsigned i = 0; i < 3000; ++i)
+        strm << "(f" << i << "    " << sym.substr(0, i) << ")";
+    strm << ";" << comment << "\n" << sym << " " << sym.substr(0, 10);
+    tokens.reset();
+    ids.reset();
+    numbers.reset();
+    scan_all(strm.str(), tokens, ids, numbers);
+    ENSURE(ids.size() == 3000 + 3000 - 1 + 2);
+    unsigned j = 0;
+    for (unsigned i = 0; i < 3000; ++i) {
+        ENSURE(ids[j++] == "f" + std::to_string(i));
+        if (i > 0)
+            ENSURE(ids[j++] == sym.substr(0, i));
+    }
+    ENSURE(ids[j++] == sym);
+    ENSURE(ids[j++] == sym.substr(0, 10));
+}
+
+static bool parse_with_threads(cmd_context& ctx, std::ostream& out, std::string const& input, unsigned threads) {
+    ctx.set_regular_stream(out);
+    ctx.set_diagnostic_stream(out);
+    ctx.set_ignore_check(true);
+    params_ref p;
+    p.set_uint("threads", threads);
+    std::istringstream in(input);
+    return parse_smt2_commands(ctx, in, false, p);
+}
+
+void tst_smt2_parallel_parse() {
+    std::ostringstream strm;
+    strm << "(set-logic ALL)\n(declare-fun f (Int) Int)\n(define-fun g ((x Int)) Int (+ x 1))\n";
+    for (unsigned i = 0; i < 300; ++i)
+        strm << "(declare-const x" << i << " Int) ; x" << i << "\n(declare-const |z" << i << ")| String)\n";
+    for (unsigned i = 0; i + 1 < 200; ++i)
+        strm << "(assert (let ((y (f x" << i << "))) (<= (g y) x" << (i + 1) << ")))\n";
+    strm << "(check-sat)\n(declare-const s String)\n";
+    for (unsigned i = 0; i < 100; ++i)
+        strm << "(assert (not (= (str.++ s \"a\"\"(|\") |z" << i << ")|)))\n";
+    for (unsigned i = 200; i < 300; ++i)
+        strm << "(assert (> x" << i << " " << i << "))\n";
+    strm << "(push)\n(assert (= x0 x1))\n";
+    std::string input = strm.str();
+
+    ast_manager m;
+    reg_decl_plugins(m);
+    std::ostringstream out;
+    cmd_context seq(false, &m), par(false, &m);
+    ENSURE(parse_with_threads(seq, out, input, 1));
+    ENSURE(parse_with_threads(par, out, input, 4));
+    ENSURE(seq.assertions().size() == 200 - 1 + 100 + 100 + 1);
+    ENSURE(seq.assertions() == par.assertions());
+
+    // a run with an error is parsed again sequentially.
+    input.insert(input.find("(check-sat)"), "(assert (= x2 undeclared))\n");
+    cmd_context seq2(false, &m), par2(false, &m);
+    ENSURE(!parse_with_threads(seq2, out, input, 1));
+    ENSURE(!parse_with_threads(par2, out, input, 4));
+    ENSURE(seq2.assertions() == par2.assertions());
+
+    // without int-real coercions the assertions are ill-sorted in both modes.
+    std::ostringstream strm2;
+    strm2 << "(set-option :int-real-coercions false)\n(declare-const x Int)\n";
+    for (unsigned i = 0; i < 70; ++i)
+        strm2 << "(assert (<= x " << i << ".5))\n";
+    ast_manager m2, m3;
+    reg_decl_plugins(m2);
+    reg_decl_plugins(m3);
+    cmd_context seq3(false, &m2), par3(false, &m3);
+    ENSURE(!parse_with_threads(seq3, out, strm2.str(), 1));
+    ENSURE(!parse_with_threads(par3, out, strm2.str(), 4));
+    ENSURE(seq3.assertions().empty());
+    ENSURE(par3.assertions().empty());
+}
+
+static std::string mk_benchmark(unsigned n) {
+    std::ostringstream strm;
+    strm << "(set-logic ALL)\n";
+    for (unsigned i = 0; i < n; ++i)
+        strm << "(declare-const x" << i << " Int)\n"
+             << "(declare-const b" << i << " (_ BitVec 32))\n";
+    for (unsigned i = 0; i + 1 < n; ++i)
+        strm << "; constraint " << i << "\n"
+             << "(assert (or (<= (+ x" << i << " (* 3 x" << (i + 1) << ")) " << (1234567890123ull * i) << ")\n"
+             << "            (= (bvadd b" << i << " #x0000ffff) b" << (i + 1) << ")))\n";
+    return strm.str();
+}
+
+void tst_smt2_parse(char ** argv, int argc, int& i) {
+    std::string input;
+    unsigned threads = 4;
+    if (i + 1 < argc) {
+        char const* file_name = argv[i + 1];
+        ++i;
+        if (i + 1 < argc) {
+            threads = atoi(argv[i + 1]);
+            ++i;
+        }
+        std::ifstream in(file_name, std::ios::binary);
+        if (in.bad() || in.fail()) {
+            std::cerr << "(error \"failed to open file '" << file_name << "'\")" << std::endl;
+            return;
+        }
+        std::ostringstream buffer;
+        buffer << in.rdbuf();
+        input = buffer.str();
+    }
+    else
+        input = mk_benchmark(100000);
+
+    double mb = input.size() / (1024.0 * 1024.0);
+    unsigned num_tokens = 0;
+    stopwatch sw;
+    {
+        cmd_context ctx;
+        std::istringstream in(input);
+        smt2::scanner s(ctx, in);
+        sw.start();
+        try {
+            while (s.scan() != smt2::scanner::EOF_TOKEN)
+                ++num_tokens;
+        }
+        catch (smt2::scanner_exception& ex) {
+            std::cerr << "(error \"" << ex.what() << "\")" << std::endl;
+        }
+        sw.stop();
+    }
+    double scan_secs = sw.get_seconds();
+
+    sw.reset();
+    {
+        cmd_context ctx;
+        ctx.set_ignore_check(true);
+        std::istringstream in(input);
+        sw.start();
+        parse_smt2_commands(ctx, in);
+        sw.stop();
+    }
+    double parse_secs = sw.get_seconds();
+
+    sw.reset();
+    {
+        cmd_context ctx;
+        ctx.set_ignore_check(true);
+        params_ref p;
+        p.set_uint("threads", threads);
+        std::istringstream in(input);
+        sw.start();
+        parse_smt2_commands(ctx, in, false, p);
+        sw.stop();
+    }
+    double par_secs = sw.get_seconds();
+
+    std::cout << "MB " << mb << " tokens " << num_tokens
+              << " scan-secs " << scan_secs << " scan-MB/sec " << (scan_secs > 0 ? mb / scan_secs : 0)
+              << " parse-secs " << parse_secs << " parse-MB/sec " << (parse_secs > 0 ? mb / parse_secs : 0)
+              << " threads " << threads << " parallel-parse-secs " << par_secs << "\n";
+}
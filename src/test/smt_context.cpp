@@ -5,7 +5,353 @@ Copyright (c) 2015 Microsoft Corporation
 --*/
 
 #include "smt/smt_context.h"
+#include "smt/smt_solver.h"
 #include "ast/reg_decl_plugins.h"
+#include "ast/bv_decl_plugin.h"
+#include "ast/arith_decl_plugin.h"
+#ifndef SINGLE_THREAD
+#include <thread>
+#include <chrono>
+#endif
+
+// pigeon hole problem, it is unsatisfiable if there are more pigeons than holes.
+static void mk_pigeon_hole(ast_manager& m, unsigned num_pigeons, unsigned num_holes, expr_ref_vector& fmls) {
+    vector<expr_ref_vector> p;
+    for (unsigned i = 0; i < num_pigeons; ++i) {
+        p.push_back(expr_ref_vector(m));
+        for (unsigned j = 0; j < num_holes; ++j)
+            p[i].push_back(m.mk_fresh_const("p", m.mk_bool_sort()));
+        fmls.push_back(m.mk_or(p[i]));
+    }
+    for (unsigned j = 0; j < num_holes; ++j)
+        for (unsigned i = 0; i < num_pigeons; ++i)
+            for (unsigned k = i + 1; k < num_pigeons; ++k)
+                fmls.push_back(m.mk_not(m.mk_and(p[i].get(j), p[k].get(j))));
+}
+
+// cancel a cube-and-conquer run, the workers have to return.
+static void tst_cube_and_conquer_cancel() {
+#ifndef SINGLE_THREAD
+    smt_params params;
+    params.m_threads = 4;
+    params.m_threads_cube_and_conquer = true;
+    params.m_threads_max_conflicts = 100;
+    ast_manager m;
+    reg_decl_plugins(m);
+    smt::context ctx(m, params);
+    expr_ref_vector fmls(m);
+    mk_pigeon_hole(m, 12, 11, fmls);
+    for (expr* f : fmls)
+        ctx.assert_expr(f);
+    std::thread canceler([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        m.limit().cancel();
+    });
+    lbool r = ctx.check();
+    canceler.join();
+    ENSURE(r == l_undef);
+#endif
+}
+
+static double get_stat(smt::context& ctx, char const* key) {
+    statistics st;
+    ctx.collect_statistics(st);
+    return st.get_value(key);
+}
+
+// cube-and-conquer returns a core of the assumptions, and a model of the assertions.
+static void tst_cube_and_conquer_results() {
+#ifndef SINGLE_THREAD
+    smt_params params;
+    params.m_threads = 4;
+    params.m_threads_cube_and_conquer = true;
+    params.m_threads_max_conflicts = 20;
+    ast_manager m;
+    reg_decl_plugins(m);
+    {
+        smt::context ctx(m, params);
+        expr_ref_vector fmls(m);
+        mk_pigeon_hole(m, 8, 7, fmls);
+        // the pigeon hole problem is unsatisfiable under the assumption not e, f is not needed.
+        expr_ref e(m.mk_const("e", m.mk_bool_sort()), m), f(m.mk_const("f", m.mk_bool_sort()), m);
+        for (expr* fml : fmls)
+            ctx.assert_expr(m.mk_or(e, fml));
+        expr_ref_vector asms(m);
+        asms.push_back(m.mk_not(e));
+        asms.push_back(f);
+        ENSURE(ctx.check(asms.size(), asms.data()) == l_false);
+        std::cout << "cubes " << get_stat(ctx, "smt.cubes") << " core " << ctx.unsat_core().size() << "\n";
+        ENSURE(get_stat(ctx, "smt.cubes") > 0);
+        for (expr* c : ctx.unsat_core())
+            ENSURE(asms.contains(c));
+        ENSURE(ctx.unsat_core().contains(asms.get(0)));
+    }
+    {
+        // random 3-CNF that is satisfied by a hidden assignment.
+        smt::context ctx(m, params);
+        random_gen rand(0);
+        unsigned num_vars = 250;
+        expr_ref_vector vars(m), fmls(m);
+        bool_vector hidden;
+        for (unsigned i = 0; i < num_vars; ++i) {
+            vars.push_back(m.mk_fresh_const("x", m.mk_bool_sort()));
+            hidden.push_back(rand(2) == 0);
+        }
+        while (fmls.size() < (num_vars * 426) / 100) {
+            expr_ref_vector lits(m);
+            bool sat = false;
+            for (unsigned j = 0; j < 3; ++j) {
+                unsigned v = rand(num_vars);
+                bool sign = rand(2) == 0;
+                sat |= hidden[v] != sign;
+                lits.push_back(sign ? m.mk_not(vars.get(v)) : vars.get(v));
+            }
+            if (sat)
+                fmls.push_back(m.mk_or(lits));
+        }
+        for (expr* fml : fmls)
+            ctx.assert_expr(fml);
+        ENSURE(ctx.check() == l_true);
+        std::cout << "cubes " << get_stat(ctx, "smt.cubes") << "\n";
+        ENSURE(get_stat(ctx, "smt.cubes") > 0);
+        model_ref mdl;
+        ctx.get_model(mdl);
+        ENSURE(mdl);
+        for (expr* fml : fmls)
+            ENSURE(mdl->is_true(fml));
+    }
+#endif
+}
+
+// chronological backtracking does not change results.
+static void tst_chrono_backtrack() {
+    double chrono_backtracks = 0;
+    for (unsigned num_holes = 5; num_holes <= 7; ++num_holes) {
+        for (unsigned num_pigeons = num_holes; num_pigeons <= num_holes + 1; ++num_pigeons) {
+            smt_params params;
+            params.m_chrono_backtrack = 1;
+            ast_manager m;
+            reg_decl_plugins(m);
+            smt::context ctx(m, params);
+            expr_ref_vector fmls(m);
+            mk_pigeon_hole(m, num_pigeons, num_holes, fmls);
+            for (expr* f : fmls)
+                ctx.assert_expr(f);
+            lbool r = ctx.check();
+            ENSURE(r == (num_pigeons > num_holes ? l_false : l_true));
+            if (r == l_true) {
+                model_ref mdl;
+                ctx.get_model(mdl);
+                for (expr* f : fmls)
+                    ENSURE(mdl->is_true(f));
+            }
+            chrono_backtracks += get_stat(ctx, "chrono backtracks");
+        }
+    }
+    std::cout << "chrono backtracks " << chrono_backtracks << "\n";
+    ENSURE(chrono_backtracks > 0);
+}
+
+// with bv.delay a delayed multiplier is not bit-blasted again after each backjump.
+static void tst_bv_delay_blasts() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    bv_util bv(m);
+    smt_params params;
+    params.m_bv_delay = true;
+    smt::context ctx(m, params);
+    expr_ref x(m.mk_const("x", bv.mk_sort(32)), m), y(m.mk_const("y", bv.mk_sort(32)), m);
+    expr_ref one(bv.mk_numeral(rational(1), 32), m);
+    ctx.assert_expr(m.mk_eq(bv.mk_bv_mul(x, y), bv.mk_numeral(rational(7), 32)));
+    ctx.assert_expr(m.mk_not(bv.mk_ule(x, one)));
+    ctx.assert_expr(m.mk_not(bv.mk_ule(y, one)));
+    unsigned num_checks = 0;
+    for (unsigned i = 0; i < 5; ++i) {
+        ENSURE(ctx.check() == l_true);
+        ctx.push();
+        // the product of an even number is even.
+        ctx.assert_expr(m.mk_eq(bv.mk_extract(0, 0, x), bv.mk_numeral(rational(0), 1)));
+        ENSURE(ctx.check() == l_false);
+        ctx.pop(1);
+        num_checks += 2;
+    }
+    double blasts = get_stat(ctx, "bv delay blasts");
+    std::cout << "bv delay blasts " << blasts << " checks " << num_checks << "\n";
+    // x * y is blasted once in final check and once more at the search level.
+    ENSURE(blasts <= 2);
+}
+
+// cached arithmetic lemmas are added again after pop and do not change results.
+static void tst_arith_cached_lemmas() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    smt_params params1, params2;
+    params2.m_arith_cache_lemmas = true;
+    smt::context ctx1(m, params1), ctx2(m, params2);
+    expr_ref x(m.mk_const("x", a.mk_real()), m), y(m.mk_const("y", a.mk_real()), m);
+    expr_ref_vector fmls(m);
+    for (expr* v : { x.get(), y.get() }) {
+        fmls.push_back(a.mk_ge(v, a.mk_real(1)));
+        fmls.push_back(a.mk_le(v, a.mk_real(10)));
+    }
+    fmls.push_back(a.mk_le(a.mk_add(x, y), a.mk_real(9)));
+    expr_ref xy(a.mk_mul(x, y), m);
+    for (unsigned round = 0; round < 2; ++round) {
+        for (unsigned k = 0; k < 20; ++k) {
+            lbool r[2];
+            smt::context* ctxs[2] = { &ctx1, &ctx2 };
+            for (unsigned i = 0; i < 2; ++i) {
+                ctxs[i]->push();
+                for (expr* f : fmls)
+                    ctxs[i]->assert_expr(f);
+                ctxs[i]->assert_expr(a.mk_ge(xy, a.mk_real(18 + k)));
+                r[i] = ctxs[i]->check();
+                ctxs[i]->pop(1);
+            }
+            ENSURE(r[0] != l_undef);
+            ENSURE(r[0] == r[1]);
+        }
+    }
+    double cached = get_stat(ctx2, "arith-cached-lemmas");
+    std::cout << "arith-cached-lemmas " << cached << "\n";
+    ENSURE(cached > 0);
+}
+
+// cached cuts are added again after pop and do not change results.
+static void tst_arith_cached_cuts() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    double cached = 0, cuts = 0;
+    for (unsigned seed = 0; seed < 10; ++seed) {
+        smt_params params1, params2;
+        // cut often, so that the problems are not only solved by patching and branching.
+        params1.m_arith_branch_cut_ratio = 1;
+        params2.m_arith_branch_cut_ratio = 1;
+        params2.m_arith_cache_lemmas = true;
+        smt::context ctx1(m, params1), ctx2(m, params2);
+        random_gen rand(seed);
+        expr_ref_vector xs(m), fmls(m);
+        for (unsigned i = 0; i < 3; ++i) {
+            xs.push_back(m.mk_fresh_const("x", a.mk_int()));
+            fmls.push_back(a.mk_ge(xs.get(i), a.mk_int(0)));
+            fmls.push_back(a.mk_le(xs.get(i), a.mk_int(20)));
+        }
+        auto mk_sum = [&](int lo, int hi) {
+            expr_ref_vector ts(m);
+            for (expr* x : xs)
+                ts.push_back(a.mk_mul(a.mk_int(lo + static_cast<int>(rand(hi - lo + 1))), x));
+            return expr_ref(a.mk_add(ts), m);
+        };
+        for (unsigned i = 0; i < 3; ++i)
+            fmls.push_back(a.mk_le(mk_sum(-9, 9), a.mk_int(static_cast<int>(rand(41)) - 10)));
+        expr_ref_vector extras(m);
+        for (unsigned k = 0; k < 10; ++k)
+            extras.push_back(a.mk_ge(mk_sum(1, 9), a.mk_int(k + 5)));
+        for (unsigned round = 0; round < 2; ++round) {
+            for (expr* extra : extras) {
+                lbool r[2];
+                smt::context* ctxs[2] = { &ctx1, &ctx2 };
+                for (unsigned i = 0; i < 2; ++i) {
+                    ctxs[i]->push();
+                    for (expr* f : fmls)
+                        ctxs[i]->assert_expr(f);
+                    ctxs[i]->assert_expr(extra);
+                    r[i] = ctxs[i]->check();
+                    ctxs[i]->pop(1);
+                }
+                ENSURE(r[0] != l_undef);
+                ENSURE(r[0] == r[1]);
+            }
+        }
+        cached += get_stat(ctx2, "arith-cached-lemmas");
+        cuts += get_stat(ctx2, "arith-gomory-cuts");
+    }
+    std::cout << "arith-gomory-cuts " << cuts << " arith-cached-lemmas " << cached << "\n";
+    ENSURE(cached > 0);
+}
+
+// checking the quantifiers of mbqi in parallel gives the same results as checking them in turn.
+static void tst_mbqi_threads() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    sort* int_s = a.mk_int();
+    func_decl_ref f(m.mk_func_decl(symbol("f"), int_s, int_s), m);
+    func_decl_ref g(m.mk_func_decl(symbol("g"), int_s, int_s), m);
+    func_decl_ref h(m.mk_func_decl(symbol("h"), int_s, int_s), m);
+    expr_ref x(m.mk_var(0, int_s), m);
+    symbol xn("x");
+    expr_ref c(m.mk_const("c", int_s), m), d(m.mk_const("d", int_s), m);
+    // h(d) >= g(d) + k = f(d) + 1 + k >= 1 + k.
+    auto mk_fmls = [&](unsigned k, int b, expr_ref_vector& fmls) {
+        fmls.push_back(m.mk_forall(1, &int_s, &xn, a.mk_ge(m.mk_app(f, x.get()), a.mk_int(0))));
+        fmls.push_back(m.mk_forall(1, &int_s, &xn, m.mk_eq(m.mk_app(g, x.get()), a.mk_add(m.mk_app(f, x.get()), a.mk_int(1)))));
+        fmls.push_back(m.mk_forall(1, &int_s, &xn, a.mk_ge(m.mk_app(h, x.get()), a.mk_add(m.mk_app(g, x.get()), a.mk_int(k)))));
+        fmls.push_back(m.mk_eq(m.mk_app(f, c.get()), a.mk_int(2)));
+        fmls.push_back(a.mk_le(m.mk_app(h, d.get()), a.mk_int(b)));
+    };
+    for (unsigned k = 0; k < 3; ++k) {
+        for (int b = 0; b < 5; ++b) {
+            lbool r[2];
+            for (unsigned i = 0; i < 2; ++i) {
+                smt_params params;
+                // instances come from the model checker only.
+                params.m_ematching = false;
+                params.m_mbqi_threads = i == 0 ? 1 : 4;
+                smt::context ctx(m, params);
+                expr_ref_vector fmls(m);
+                mk_fmls(k, b, fmls);
+                for (expr* fml : fmls)
+                    ctx.assert_expr(fml);
+                r[i] = ctx.check();
+                if (r[i] == l_true) {
+                    model_ref mdl;
+                    ctx.get_model(mdl);
+                    for (unsigned j = 3; j < fmls.size(); ++j)
+                        ENSURE(mdl->is_true(fmls.get(j)));
+                }
+            }
+            ENSURE(r[0] == (b < static_cast<int>(k) + 1 ? l_false : l_true));
+            ENSURE(r[0] == r[1]);
+        }
+    }
+}
+
+// a fork keeps the lemmas of its parent and gives the same results as the parent.
+static void tst_fork() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    expr_ref_vector fmls(m);
+    mk_pigeon_hole(m, 8, 7, fmls);
+    // the pigeon hole problem is unsatisfiable under the assumption not e.
+    expr_ref e(m.mk_const("e", m.mk_bool_sort()), m), not_e(m.mk_not(e), m);
+    smt_params params;
+    smt::context ctx(m, params);
+    for (expr* f : fmls)
+        ctx.assert_expr(m.mk_or(e, f));
+    expr* assumptions[1] = { not_e.get() };
+    ENSURE(ctx.check(1, assumptions) == l_false);
+    ENSURE(!ctx.get_lemmas().empty());
+    smt::context ctx2(m, params);
+    smt::context::copy(ctx, ctx2, true, true);
+    std::cout << "lemmas " << ctx.get_lemmas().size() << " copied " << ctx2.get_lemmas().size() << "\n";
+    ENSURE(!ctx2.get_lemmas().empty());
+    ENSURE(ctx2.get_lemmas().size() <= ctx.get_lemmas().size());
+    ENSURE(ctx2.check(1, assumptions) == l_false);
+    ENSURE(ctx2.check() == l_true);
+
+    ref<solver> s = mk_smt_solver(m, params_ref(), symbol::null);
+    for (expr* f : fmls)
+        s->assert_expr(m.mk_or(e, f));
+    ENSURE(s->check_sat(1, assumptions) == l_false);
+    ref<solver> s2 = s->fork(params_ref());
+    ENSURE(s2->check_sat(1, assumptions) == l_false);
+    s2->assert_expr(not_e);
+    ENSURE(s2->check_sat() == l_false);
+    ENSURE(s->check_sat() == l_true);
+}
 
 void tst_smt_context()
 {
@@ -34,4 +380,13 @@ void tst_smt_context()
     }
 
     ctx.check();
+
+    tst_cube_and_conquer_cancel();
+    tst_cube_and_conquer_results();
+    tst_bv_delay_blasts();
+    tst_chrono_backtrack();
+    tst_arith_cached_lemmas();
+    tst_arith_cached_cuts();
+    tst_mbqi_threads();
+    tst_fork();
 }
@@ -92,18 +92,118 @@ bool mpn_manager::sub(mpn_digit const * a, unsigned lnga,
     return true; // return k != 0?
 }
 
+#define DIGIT_BITS (sizeof(mpn_digit)*8)
+#define HALF_BITS (sizeof(mpn_digit)*4)
+
+// Operands with fewer digits are multiplied using the schoolbook method.
+static const unsigned KARATSUBA_THRESHOLD = 32;
+
+// c[0..lngc) += a[0..lnga), returns the carry out of c.
+static mpn_digit add_to(mpn_digit * c, unsigned lngc, mpn_digit const * a, unsigned lnga) {
+    SASSERT(lnga <= lngc);
+    mpn_digit k = 0;
+    unsigned j = 0;
+    for (; j < lnga; j++) {
+        mpn_double_digit t = (mpn_double_digit)c[j] + (mpn_double_digit)a[j] + (mpn_double_digit)k;
+        c[j] = static_cast<mpn_digit>(t);
+        k = static_cast<mpn_digit>(t >> DIGIT_BITS);
+    }
+    for (; k != 0 && j < lngc; j++) {
+        c[j] += k;
+        k = c[j] == 0;
+    }
+    return k;
+}
+
+// c[0..lngc) -= a[0..lnga), returns the borrow out of c.
+static mpn_digit sub_from(mpn_digit * c, unsigned lngc, mpn_digit const * a, unsigned lnga) {
+    SASSERT(lnga <= lngc);
+    mpn_digit k = 0;
+    unsigned j = 0;
+    for (; j < lnga; j++) {
+        mpn_digit r = c[j] - a[j];
+        bool c1 = r > c[j];
+        c[j] = r - k;
+        bool c2 = c[j] > r;
+        k = c1 | c2;
+    }
+    for (; k != 0 && j < lngc; j++) {
+        k = c[j] == 0;
+        c[j]--;
+    }
+    return k;
+}
+
 bool mpn_manager::mul(mpn_digit const * a, unsigned lnga,
                       mpn_digit const * b, unsigned lngb,
                       mpn_digit * c) const {
     trace(a, lnga, b, lngb, "*");
+    mul_rec(a, lnga, b, lngb, c);
+    trace_nl(c, lnga+lngb);
+    return true;
+}
+
+void mpn_manager::mul_rec(mpn_digit const * a, unsigned lnga,
+                          mpn_digit const * b, unsigned lngb,
+                          mpn_digit * c) const {
+    if (lnga < lngb) {
+        std::swap(a, b);
+        std::swap(lnga, lngb);
+    }
+    if (lngb < KARATSUBA_THRESHOLD) {
+        mul_basecase(a, lnga, b, lngb, c);
+        return;
+    }
+    if (lnga == lngb) {
+        mul_karatsuba(a, b, lnga, c);
+        return;
+    }
+    // unbalanced operands: multiply b with slices of a of the same length as b.
+    for (unsigned i = 0; i < lnga + lngb; i++)
+        c[i] = 0;
+    mpn_sbuffer t(2 * lngb, 0);
+    for (unsigned i = 0; i < lnga; i += lngb) {
+        unsigned len = std::min(lngb, lnga - i);
+        mul_rec(a + i, len, b, lngb, t.data());
+        VERIFY(0 == add_to(c + i, lnga + lngb - i, t.data(), len + lngb));
+    }
+}
+
+void mpn_manager::mul_karatsuba(mpn_digit const * a, mpn_digit const * b, 
+                                unsigned lng, mpn_digit * c) const {
+    // a = a1*B^m + a0, b = b1*B^m + b0
+    // a*b = a1*b1*B^2m + ((a0 + a1)*(b0 + b1) - a0*b0 - a1*b1)*B^m + a0*b0
+    unsigned m = lng / 2;
+    unsigned h = lng - m;
+    SASSERT(m >= 2 && h >= m);
+    mpn_digit const * a0 = a, * a1 = a + m;
+    mpn_digit const * b0 = b, * b1 = b + m;
+
+    mul_rec(a0, m, b0, m, c);
+    mul_rec(a1, h, b1, h, c + 2 * m);
+
+    mpn_sbuffer sa(h + 1, 0), sb(h + 1, 0), t(2 * h + 2, 0);
+    for (unsigned i = 0; i < h; i++) {
+        sa[i] = a1[i];
+        sb[i] = b1[i];
+    }
+    sa[h] = add_to(sa.data(), h, a0, m);
+    sb[h] = add_to(sb.data(), h, b0, m);
+    mul_rec(sa.data(), h + 1, sb.data(), h + 1, t.data());
+    VERIFY(0 == sub_from(t.data(), 2 * h + 2, c, 2 * m));
+    VERIFY(0 == sub_from(t.data(), 2 * h + 2, c + 2 * m, 2 * h));
+    // the middle term is below B^(m+h+1), so its digits beyond lng + h are 0.
+    SASSERT(2 * h + 2 <= lng + h);
+    VERIFY(0 == add_to(c + m, lng + h, t.data(), 2 * h + 2));
+}
+
+void mpn_manager::mul_basecase(mpn_digit const * a, unsigned lnga,
+                               mpn_digit const * b, unsigned lngb,
+                               mpn_digit * c) const {
     // Essentially Knuth's Algorithm M. 
-    // Perhaps implement a more efficient version, see e.g., Knuth, Section 4.3.3.    
     unsigned i;
     mpn_digit k;
 
-#define DIGIT_BITS (sizeof(mpn_digit)*8)
-#define HALF_BITS (sizeof(mpn_digit)*4)
-
     for (unsigned i = 0; i < lnga; i++)
         c[i] = 0;
 
@@ -127,9 +227,6 @@ bool mpn_manager::mul(mpn_digit const * a, unsigned lnga,
             c[j+lnga] = k;
         }        
     }
-    
-    trace_nl(c, lnga+lngb);
-    return true;
 }
 
 #define MASK_FIRST (~((mpn_digit)(-1) >> 1))
@@ -55,6 +55,17 @@ private:
 
     void display_raw(std::ostream & out, mpn_digit const * a, unsigned lng) const;
 
+    void mul_basecase(mpn_digit const * a, unsigned lnga,
+                      mpn_digit const * b, unsigned lngb,
+                      mpn_digit * c) const;
+
+    void mul_rec(mpn_digit const * a, unsigned lnga,
+                 mpn_digit const * b, unsigned lngb,
+                 mpn_digit * c) const;
+
+    void mul_karatsuba(mpn_digit const * a, mpn_digit const * b, 
+                       unsigned lng, mpn_digit * c) const;
+
     unsigned div_normalize(mpn_digit const * numer, unsigned lnum,
                          mpn_digit const * denom, unsigned lden,
                          mpn_sbuffer & n_numer,
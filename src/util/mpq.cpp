@@ -20,6 +20,15 @@ Revision History:
 #include "util/warning.h"
 #include "util/z3_exception.h"
 
+static uint64_t gcd_u64(uint64_t u, uint64_t v) {
+    while (v != 0) {
+        uint64_t r = u % v;
+        u = v;
+        v = r;
+    }
+    return u;
+}
+
 template<bool SYNCH>
 mpq_manager<SYNCH>::~mpq_manager() {
     del(m_tmp1);
@@ -33,6 +42,12 @@ mpq_manager<SYNCH>::~mpq_manager() {
 
 template<bool SYNCH>
 bool mpq_manager<SYNCH>::rat_lt(mpq const & a, mpq const & b) {
+    if (is_small(a) && is_small(b)) {
+        // denominators are positive
+        return 
+            static_cast<int64_t>(a.m_num.value()) * b.m_den.value() < 
+            static_cast<int64_t>(b.m_num.value()) * a.m_den.value();
+    }
     mpz const & na = a.numerator();
     mpz const & nb = b.numerator();
     int sign_a = this->sign(na);
@@ -351,6 +366,37 @@ void mpq_manager<SYNCH>::lin_arith_op(mpq const& a, mpq const& b, mpq& c, mpz& g
     }                                           
 }
 
+template<bool SYNCH>
+void mpq_manager<SYNCH>::set_small(mpq& c, int64_t n, int64_t d) {
+    SASSERT(d > 0);
+    uint64_t g = gcd_u64(n < 0 ? 0 - static_cast<uint64_t>(n) : static_cast<uint64_t>(n), static_cast<uint64_t>(d));
+    if (g > 1) {
+        n /= static_cast<int64_t>(g);
+        d /= static_cast<int64_t>(g);
+    }
+    mpz_manager<SYNCH>::set(c.m_num, n);
+    mpz_manager<SYNCH>::set(c.m_den, d);
+}
+
+template<bool SYNCH>
+template<bool SUB>
+void mpq_manager<SYNCH>::small_lin_arith_op(mpq const& a, mpq const& b, mpq& c) {
+    // |numerator|, |denominator| <= 2^31, so products are bounded by 2^62.
+    int64_t an = a.m_num.value(), ad = a.m_den.value();
+    int64_t bn = b.m_num.value(), bd = b.m_den.value();
+    if (ad == bd) 
+        set_small(c, SUB ? an - bn : an + bn, ad);
+    else 
+        set_small(c, SUB ? an * bd - bn * ad : an * bd + bn * ad, ad * bd);
+}
+
+template<bool SYNCH>
+void mpq_manager<SYNCH>::small_mul(mpq const& a, mpq const& b, mpq& c) {
+    int64_t an = a.m_num.value(), ad = a.m_den.value();
+    int64_t bn = b.m_num.value(), bd = b.m_den.value();
+    set_small(c, an * bn, ad * bd);
+}
+
 template<bool SYNCH>
 void mpq_manager<SYNCH>::rat_mul(mpq const & a, mpq const & b, mpq & c, mpz& g1, mpz& g2, mpz& tmp1, mpz& tmp2) {
 #if 1
@@ -382,7 +428,10 @@ void mpq_manager<SYNCH>::rat_mul(mpz const & a, mpq const & b, mpq & c) {
 template<bool SYNCH>
 void mpq_manager<SYNCH>::rat_mul(mpq const & a, mpq const & b, mpq & c) {
     STRACE("rat_mpq", tout << "[mpq] " << to_string(a) << " * " << to_string(b) << " == ";); 
-    if (SYNCH) {
+    if (is_small(a) && is_small(b)) {
+        small_mul(a, b, c);
+    }
+    else if (SYNCH) {
         mpz g1, g2, tmp1, tmp2;
         rat_mul(a, b, c, g1, g2, tmp1, tmp2);
         del(g1);
@@ -399,7 +448,10 @@ void mpq_manager<SYNCH>::rat_mul(mpq const & a, mpq const & b, mpq & c) {
 template<bool SYNCH>
 void mpq_manager<SYNCH>::rat_add(mpq const & a, mpq const & b, mpq & c) {
     STRACE("rat_mpq", tout << "[mpq] " << to_string(a) << " + " << to_string(b) << " == ";); 
-    if (SYNCH) {
+    if (is_small(a) && is_small(b)) {
+        small_lin_arith_op<false>(a, b, c);
+    }
+    else if (SYNCH) {
         mpz_stack tmp1, tmp2, tmp3, g;
         lin_arith_op<false>(a, b, c, g, tmp1, tmp2, tmp3);
         del(tmp1);
@@ -416,7 +468,10 @@ void mpq_manager<SYNCH>::rat_add(mpq const & a, mpq const & b, mpq & c) {
 template<bool SYNCH>
 void mpq_manager<SYNCH>::rat_sub(mpq const & a, mpq const & b, mpq & c) {
     STRACE("rat_mpq", tout << "[mpq] " << to_string(a) << " - " << to_string(b) << " == ";); 
-    if (SYNCH) {
+    if (is_small(a) && is_small(b)) {
+        small_lin_arith_op<true>(a, b, c);
+    }
+    else if (SYNCH) {
         mpz tmp1, tmp2, tmp3, g;
         lin_arith_op<true>(a, b, c, g, tmp1, tmp2, tmp3);
         del(tmp1);
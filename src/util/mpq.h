@@ -105,6 +105,15 @@ class mpq_manager : public mpz_manager<SYNCH> {
 
     void rat_mul(mpq const & a, mpq const & b, mpq & c, mpz& g1, mpz& g2, mpz& tmp1, mpz& tmp2);
 
+    // Fast paths for rationals whose numerator and denominator are small.
+    // Intermediate results fit in 64 bits, so no mpz arithmetic is needed.
+    template<bool SUB>
+    void small_lin_arith_op(mpq const& a, mpq const& b, mpq& c);
+
+    void small_mul(mpq const& a, mpq const& b, mpq& c);
+
+    void set_small(mpq& c, int64_t n, int64_t d);
+
 public:
     typedef mpq numeral;
     typedef mpq rational;
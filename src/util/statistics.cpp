@@ -222,6 +222,17 @@ double statistics::get_double_value(unsigned idx) const {
     return m_d_stats[idx - m_stats.size()].second;
 }
 
+double statistics::get_value(char const * key) const {
+    double r = 0;
+    for (auto const& kv : m_stats)
+        if (strcmp(kv.first, key) == 0)
+            r += kv.second;
+    for (auto const& kv : m_d_stats)
+        if (strcmp(kv.first, key) == 0)
+            r += kv.second;
+    return r;
+}
+
 static void get_uint64_stats(statistics& st, char const* name, unsigned long long value) {
     if (value <= UINT_MAX) {
         st.update(name, static_cast<unsigned>(value));
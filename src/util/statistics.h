@@ -40,6 +40,8 @@ public:
     char const * get_key(unsigned idx) const;
     unsigned get_uint_value(unsigned idx) const;
     double get_double_value(unsigned idx) const;
+    // sum of the values recorded for key, 0 if there is none.
+    double get_value(char const * key) const;
 };
 
 inline std::ostream& operator<<(std::ostream& out, statistics const& st) { return st.display(out); }